@@ -23,100 +23,170 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 ************************************************************************************/
-#include "EasySAT.hpp"
-#include <fstream>
+#include "internal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <sys/resource.h>
 
-#define value(lit) (lit > 0 ? value[lit] : -value[-lit])    // Get the value of a literal
-#define watch(id) (watches[vars + id])                      // Remapping a literal [-maxvar, +maxvar] to its watcher.
+std::atomic<bool> Solver::interrupted(false);
 
-char *read_whitespace(char *p) {                            // Aid function for parser
-    while ((*p >= 9 && *p <= 13) || *p == 32) ++p;
-    return p;
+double wall_clock() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-char *read_until_new_line(char *p) {                        // Aid function for parser
-    while (*p != '\n') {
-        if (*p++ == '\0') exit(1);
-    }
-    return ++p;
+long long peak_memory() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
 }
 
-char *read_int(char *p, int *i) {                           // Aid function for parser
-    bool sym = true; *i = 0;
-    p = read_whitespace(p);
-    if (*p == '-') sym = false, ++p;
-    while (*p >= '0' && *p <= '9') {
-        if (*p == '\0') return p;
-        *i = *i * 10 + *p - '0', ++p;
-    }
-    if (!sym) *i = -(*i);
-    return p;
+int ClauseArena::alloc(const std::vector<int> &c, bool learnt) {
+    int cref = memory.size();
+    memory.resize(cref + header + c.size());                        // Header followed by the literals.
+    Clause &cl = (*this)[cref];
+    cl.size = c.size(), cl.lbd = 0, cl.tier = Clause::CORE, cl.learnt = learnt, cl.xor_row = cl.deleted = cl.reloced = 0, cl.touched = 0;
+    for (int i = 0; i < (int)c.size(); i++) cl[i] = c[i];           // Copy literals
+    return cref;
+}
+
+void ClauseArena::free(int cref) {
+    Clause &c = (*this)[cref];
+    c.deleted = 1, wasted += header + c.size;
+}
+
+int ClauseArena::relocate(int cref, ClauseArena &to) {
+    Clause &c = (*this)[cref];
+    if (c.reloced) return c[0];                                     // Already moved, follow the forward reference.
+    int new_cref = to.memory.size();
+    to.memory.insert(to.memory.end(), memory.begin() + cref, memory.begin() + cref + header + c.size);
+    c.reloced = 1, c[0] = new_cref;
+    return new_cref;
 }
 
 int Solver::add_clause(std::vector<int> &c) {                   
-    clause_DB.push_back(Clause(c.size()));                          // Add a clause c into database.
-    int id = clause_DB.size() - 1;                                  // Getting clause index.
-    for (int i = 0; i < (int)c.size(); i++) clause_DB[id][i] = c[i];     // Copy literals
-    watch(-c[0]).push_back(Watcher(id, c[1]));                      // Watch this clause by literal -c[0]
-    watch(-c[1]).push_back(Watcher(id, c[0]));                      // Watch this clause by literal -c[1]
+    int id = clause_DB.alloc(c, false);                             // Add a clause c into database.
+    attach(id);
     return id;                                                      
 }
 
-int Solver::parse(char *filename) {
-    std::ifstream fin(filename);                                    // Fast load begin                                 
-    fin.seekg(0, fin.end);
-    size_t file_len = fin.tellg();
-	fin.seekg(0, fin.beg);
-	char *data = new char[file_len + 1], *p = data;
-	fin.read(data, file_len);
-	fin.close();                                                    // Fast load end
-	data[file_len] = '\0';
-    std::vector<int> buffer;                                        // Save the clause that waiting to push
-    while (*p != '\0') {
-        p = read_whitespace(p);
-        if (*p == '\0') break;
-        if (*p == 'c') p = read_until_new_line(p);
-        else if (*p == 'p') {                                                               // Deal with 'p cnf' line.
-            if (*(p + 1) == ' ' && *(p + 2) == 'c' && *(p + 3) == 'n' && *(p + 4) == 'f') {
-                p += 5, p = read_int(p, &vars), p = read_int(p, &clauses);
-                alloc_memory();
-            } 
-            else printf("PARSE ERROR! Unexpected char\n"), exit(2);                        // Wrong 'p ' line.
-        }
-        else {                                                                             
-            int32_t dimacs_lit;
-            p = read_int(p, &dimacs_lit);
-            if (*p == '\0' && dimacs_lit != 0)                                              // Unexpected EOF
-                printf("c PARSE ERROR! Unexpected EOF\n"), exit(1);
-            if (dimacs_lit == 0) {                                                          // Finish read a clause.
-                if (buffer.size() == 0) return 20;                                          // Read an empty clause.
-                if (buffer.size() == 1 && value(buffer[0]) == -1) return 20;                // Found confliction in origin clauses
-                if (buffer.size() == 1 && !value(buffer[0])) assign(buffer[0], 0, -1);      // Found an unit clause.
-                else if (buffer.size() > 1) add_clause(buffer);                             // Found a clause who has more than 1 literals.
-                buffer.clear();                                                             // For the next clause.
-            }       
-            else buffer.push_back(dimacs_lit);                                              // read a literal
-        }
-    }
-    origin_clauses = clause_DB.size();
-    return (propagate() == -1 ? 0 : 20);                                                    // Simplify by BCP.
+int Solver::add_learnt(std::vector<int> &c, int lbd) {
+    int cref = add_clause(c);
+    Clause &cl = clause_DB[cref];
+    cl.learnt = 1, cl.lbd = lbd, cl.touched = conflicts;
+    cl.tier = lbd <= core_lbd ? Clause::CORE : lbd <= tier2_lbd ? Clause::TIER2 : Clause::LOCAL;
+    learnt_DB.push_back(cref);
+    return cref;
 }
 
-void Solver::alloc_memory() {
-    value       = new int[vars + 1];
-    reason      = new int[vars + 1];
-    level       = new int[vars + 1];
-    mark        = new int[vars + 1];
-    local_best  = new int[vars + 1];
-    saved       = new int[vars + 1];
-    activity    = new double[vars + 1];
-    watches     = new std::vector<Watcher>[vars * 2 + 1];
-    conflicts = time_stamp = propagated = restarts = rephases = reduces = threshold = 0;
-    fast_lbd_sum = lbd_queue_size = lbd_queue_pos = slow_lbd_sum = 0;
+void Solver::attach(int cref) {
+    Clause &c = clause_DB[cref];
+    bool binary = c.size == 2;                                      // Binary clauses are propagated from the watcher only.
+    watch(-c[0]).push_back(Watcher(cref, c[1], binary));            // Watch this clause by literal -c[0]
+    watch(-c[1]).push_back(Watcher(cref, c[0], binary));            // Watch this clause by literal -c[1]
+}
+
+Solver::Solver() {
+    reset();
+}
+
+void Solver::reset() {
+    learnt.clear(), lbd_mark.clear(), reduce_buffer.clear(), trail.clear(), pos_in_trail.clear();
+    origin_DB.clear(), learnt_DB.clear(), clause_DB.memory.clear(), clause_DB.wasted = 0;
+    for (int i = 0; i < (int)watches.size(); i++) watches[i].clear();   // The watch lists keep their capacity.
+    value.clear(), vardata.clear(), mark.clear(), local_best.clear(), saved.clear(), activity.clear();
+    vsids.clear(), vmtf.clear(), share_cursor.clear(), share_buffer.clear(), model.clear(), elim_stack.clear();
+    eliminated.clear(), frozen.clear(), substitutes.clear(), assumptions.clear(), core.clear(), origin_buffer.clear(), parse_error.clear();
+    occurs.clear(), seen.clear(), subsume_queue.clear(), bumped.clear(), shrinking.clear(), shrink_stack.clear();
+    xors.clear(), column.clear(), xor_reasons.clear(), gauss_queue.clear(), gauss.clear(), cube_order.clear();
+    vars = clauses = conflicts = time_stamp = propagated = restarts = rephases = reduces = threshold = 0;
+    lbd_stamp = 0, lbd_fast = EMA(0.03), lbd_slow = EMA(1e-5);
     var_inc = 1, rephase_limit = 1024, reduce_limit = 8192;
-    vsids.setComp(GreaterActivity(activity));
-    for (int i = 1; i <= vars; i++) 
-        value[i] = reason[i] = level[i] = mark[i] = local_best[i] = activity[i] = saved[i] = 0, vsids.insert(i);
+    core_lbd = 2, tier2_lbd = 6, verbosity = 0, restart_margin = 0.8, rng = 0x9E3779B97F4A7C15ULL;
+    stable = false, mode_switches = 0, mode_limit = mode_length = 1000, restart_unit = 1024, luby_u = luby_v = 1;
+    exchange = NULL, proof = NULL, share_id = 0, share_lbd = 2, ok = true;
+    pre_effort = 1, pre_eliminated = pre_subsumed = pre_strengthened = pre_failed = 0;
+    parse_threads = 0, propagations = decisions = learnt_literals = learnt_clauses = 0;
+    learnt_uip_literals = minimized_literals = shrunk_literals = strengthened_reasons = 0;
+    restart_count = reused_levels = chrono_backtracks = 0, chrono_limit = 100;
+    walk_effort = 10, walks = 0, walk_flips = walk_propagations = 0;
+    inprocess_effort = 1, inprocess_limit = inprocess_interval = 5000, inprocess_propagations = 0;
+    probe_next = vivify_next = inprocessings = inprocess_failed = substituted = vivified = 0, vivify_removed = 0;
+    probe_time = substitute_time = vivify_time = 0, logged_units = 0;
+    cube_refuted = 0, lookaheads = 0;
+    xor_size = 6, gauss_dirty = false, xor_found = 0, xor_compact = 1 << 16, gauss_props = gauss_conflicts = gauss_pivots = 0;
+    propagate_time = analyze_time = reduce_time = walk_time = 0, propagate_calls = 0, start_time = report_time = wall_clock();
+    solve_start = start_time, limit_mark = 0;
+    time_limit = report_interval = 0, conflict_limit = 0, memory_limit = 0;
+    vsids.setComp(GreaterActivity(&activity));                 // Both orders start with every variable.
+    alloc_memory();
+}
+
+void Solver::alloc_memory() {
+    int old_vars = vardata.empty() ? 0 : vardata.size() - 1;
+    value.resize(2 * vars + 1, 0), vardata.resize(vars + 1, VarData{-1, 0}), mark.resize(vars + 1, 0);
+    local_best.resize(vars + 1, 0), saved.resize(vars + 1, 0), activity.resize(vars + 1, 0);
+    lbd_mark.resize(vars + 1, 0), eliminated.resize(vars + 1, 0), frozen.resize(vars + 1, 0), column.resize(vars + 1, -1);
+    substitutes.resize(vars + 1, 0), shrinking.resize(vars + 1, 0);
+    if ((int)watches.size() < 2 * vars + 1) watches.resize(2 * vars + 1);
+    for (int i = old_vars + 1; i <= vars; i++) vsids.insert(i);
+    vmtf.grow(vars);
+}
+
+int Solver::new_var() {
+    ++vars, alloc_memory();
+    return vars;
+}
+
+void Solver::freeze(int var) {
+    if (var > vars) vars = var, alloc_memory();
+    frozen[var] = 1, restore(var);
+}
+
+void Solver::restore(int var) {                             // Inprocessing replaced var by an equivalent literal.
+    int r = substitutes[var];
+    if (!r || !eliminated[var]) return;
+    restore(abs(r));                                        // r may have been replaced in a later round.
+    eliminated[var] = 0, substitutes[var] = 0;
+    vmtf.unassigned(var);
+    if (!vsids.inHeap(var)) vsids.insert(var);
+    std::vector<int> c(2);
+    c[0] = var, c[1] = -r, add_origin(c);
+    c[0] = -var, c[1] = r, add_origin(c);
+}
+
+bool Solver::add_origin(const std::vector<int> &c) {
+    if (!ok) return false;
+    backtrack(0);
+    for (int i = 0; i < (int)c.size(); i++) {               // Variables substituted during search come back first.
+        if (abs(c[i]) > vars) vars = abs(c[i]), alloc_memory();
+        restore(abs(c[i]));
+    }
+    origin_buffer.clear();
+    time_stamp += 2;                                        // time_stamp marks a positive literal, time_stamp - 1 a negative one.
+    for (int i = 0; i < (int)c.size(); i++) {               // Remove false and duplicated literals, skip satisfied and tautological clauses.
+        int lit = c[i], var = abs(lit), s = lit > 0 ? time_stamp : time_stamp - 1;
+        if (var > vars) vars = var, alloc_memory();
+        if (value(lit) == 1 || mark[var] == (lit > 0 ? time_stamp - 1 : time_stamp)) return true;
+        if (value(lit) == -1 || mark[var] == s) continue;
+        mark[var] = s, origin_buffer.push_back(lit);
+    }
+    if (proof && origin_buffer.size() < c.size()) proof->add(origin_buffer);  // The checker sees the clause as given.
+    if (origin_buffer.size() == 0) return ok = false;
+    if (origin_buffer.size() == 1) {                        // Found an unit clause.
+        assign(origin_buffer[0], 0, -1);
+        return ok = propagate() == -1;
+    }
+    origin_DB.push_back(add_clause(origin_buffer));
+    return true;
+}
+
+bool Solver::failed(int lit) {
+    return std::find(core.begin(), core.end(), lit) != core.end();
+}
+
+int Solver::model_value(int lit) {                          // 0 unless the last solve() found a model with lit in it.
+    if (abs(lit) >= (int)model.size()) return 0;
+    return lit > 0 ? model[lit] : -model[-lit];
 }
 
 void Solver::bump_var(int var, double coeff) {
@@ -128,14 +198,20 @@ void Solver::bump_var(int var, double coeff) {
 
 void Solver::assign(int lit, int l, int cref) {
     int var = abs(lit);
-    value[var]  = lit > 0 ? 1 : -1;
-    level[var]  = l, reason[var] = cref;                                         
+    value(lit) = 1, value(-lit) = -1;
+    level(var) = l, reason(var) = cref;
     trail.push_back(lit);
 }
 
 int Solver::propagate() {
+    if (gauss_dirty) {                                  // Unassigned rows may have become unit.
+        for (int r = 0; r < gauss.rows; r++) gauss_queue.push_back(r);
+        int cref = gauss_check();
+        if (cref != -1) return cref;
+    }
     while (propagated < (int)trail.size()) { 
         int p = trail[propagated++];                    // Pick an unpropagated literal in trail.
+        ++propagations;
         std::vector<Watcher> &ws = watch(p);            // Fetch the watcher for this literal.
         int i, j, size = ws.size();                     
         for (i = j = 0; i < size; ) {               
@@ -143,6 +219,17 @@ int Solver::propagate() {
             if (value(blocker) == 1) {                  // Pre-judge whether the clause is already SAT
                 ws[j++] = ws[i++]; continue;
             }
+            if (ws[i].binary) {                         // A binary clause is unit or conflicting without fetching it.
+                int cref = ws[i].idx_clause;
+                ws[j++] = ws[i++];
+                if (value(blocker) == -1) {             // There is a confliction
+                    while (i < size) ws[j++] = ws[i++];
+                    ws.resize(j);
+                    return cref;
+                }
+                assign(blocker, level(abs(p)), cref);
+                continue;
+            }
             int cref = ws[i].idx_clause, k, sz;
             Clause& c = clause_DB[cref];                // Fetch a clause from watcher
             if (c[0] == -p) c[0] = c[1], c[1] = -p;     // Make sure c[1] is the false literal (-p).
@@ -151,7 +238,7 @@ int Solver::propagate() {
             if (value(c[0]) == 1) {                     // Check whether another lit is SAT.
                 ws[j++] = w; continue;
             }
-            for (k = 2, sz = c.lit.size(); k < sz && value(c[k]) == -1; k++);    // Find a new watch literal.
+            for (k = 2, sz = c.size; k < sz && value(c[k]) == -1; k++);    // Find a new watch literal.
             if (k < sz) {                               // Move the watch literal to the second place
                 c[1] = c[k], c[k] = -p;
                 watch(-c[1]).push_back(w);
@@ -163,10 +250,19 @@ int Solver::propagate() {
                     ws.resize(j);
                     return cref;
                 }
-                else assign(c[0], level[abs(p)], cref);// Find a new unit clause and assign it.
+                else {                                  // Find a new unit clause and assign it.
+                    int l = level(abs(p));
+                    if (l < (int)pos_in_trail.size())   // Propagated below the current level, imply at the highest one.
+                        for (k = 2; k < sz; k++) l = std::max(l, level(abs(c[k])));
+                    assign(c[0], l, cref);
+                }
             }
         }
         ws.resize(j);
+        if (gauss.rows && column[abs(p)] >= 0) {        // Rows of the XOR matrix.
+            int cref = gauss_propagate(abs(p));
+            if (cref != -1) return cref;
+        }
     }
     return -1;                                          // Meet a convergence
 }
@@ -175,169 +271,542 @@ int Solver::analyze(int conflict, int &backtrackLevel, int &lbd) {
     ++time_stamp;
     learnt.clear();
     Clause &c = clause_DB[conflict]; 
-    int highestLevel = level[abs(c[0])];
+    int highestLevel = 0, count = 0, forced = 0;
+    for (int i = 0; i < c.size; i++) {              // Out-of-order assignments can conflict below the current level.
+        int l = level(abs(c[i]));
+        if (l > highestLevel) highestLevel = l, count = 1, forced = i;
+        else if (l == highestLevel) count++;
+    }
     if (highestLevel == 0) return 20;
+    if (count == 1) return missed_implication(conflict, forced), 0;
+    backtrack(highestLevel);
     learnt.push_back(0);        // leave a place to save the First-UIP
-    std::vector<int> bump;      // The variables to bump
+    bumped.clear();
     int should_visit_ct = 0,    // The number of literals that have not been visited in the higest level of the implication graph.
         resolve_lit = 0,        // The literal to do resolution.
         index = trail.size() - 1;
     do {
         Clause &c = clause_DB[conflict];
-        for (int i = (resolve_lit == 0 ? 0 : 1); i < (int)c.lit.size(); i++) {
+        if (resolve_lit != 0 && c.size == 2 && c[0] != resolve_lit)    // Binary reasons are not reordered in BCP.
+            c[1] = c[0], c[0] = resolve_lit;
+        if (c.learnt) update_learnt(c);
+        int fixed = 0;          // Level 0 literals of the clause, they are left out of the resolvent.
+        for (int i = (resolve_lit == 0 ? 0 : 1); i < c.size; i++) {
             int var = abs(c[i]);
-            if (mark[var] != time_stamp && level[var] > 0) {
-                bump_var(var, 0.5);
-                bump.push_back(var);
+            if (!level(var)) fixed++;
+            else if (mark[var] != time_stamp) {
+                if (stable) bump_var(var, 0.5);
+                bumped.push_back(var);
                 mark[var] = time_stamp;
-                if (level[var] >= highestLevel) should_visit_ct++;
+                if (level(var) >= highestLevel) should_visit_ct++;
                 else learnt.push_back(c[i]);
             }
         }
+        if (resolve_lit != 0 && !fixed && should_visit_ct > 1 && (int)learnt.size() + should_visit_ct == c.size)
+            strengthen_reason(conflict);             // The resolvent is the reason without its implied literal.
         do {                                         // Find the last marked literal in the trail to do resolution.
             while (mark[abs(trail[index--])] != time_stamp);
             resolve_lit = trail[index + 1];
-        } while (level[abs(resolve_lit)] < highestLevel);
-        conflict = reason[abs(resolve_lit)], mark[abs(resolve_lit)] = 0, should_visit_ct--;
+        } while (level(abs(resolve_lit)) < highestLevel);
+        conflict = reason(abs(resolve_lit)), mark[abs(resolve_lit)] = 0, should_visit_ct--;
+        if (conflict < -1) conflict = xor_reason(abs(resolve_lit));    // Implied by a row, the clause is built now.
     } while (should_visit_ct > 0);                   // Have find the convergence node in the highest level (First UIP)
-    learnt[0] = -resolve_lit;
-    ++time_stamp, lbd = 0;
-    for (int i = 0; i < (int)learnt.size(); i++) {   // Calculate the LBD.
-        int l = level[abs(learnt[i])];
-        if (l && mark[l] != time_stamp) 
-            mark[l] = time_stamp, ++lbd;
-    }
-    if (lbd_queue_size < 50) lbd_queue_size++;       // update fast-slow.
-    else fast_lbd_sum -= lbd_queue[lbd_queue_pos];
-    fast_lbd_sum += lbd, lbd_queue[lbd_queue_pos++] = lbd;
-    if (lbd_queue_pos == 50) lbd_queue_pos = 0;
-    slow_lbd_sum += (lbd > 50 ? 50 : lbd);
+    learnt[0] = -resolve_lit, mark[abs(resolve_lit)] = time_stamp;
+    learnt_uip_literals += learnt.size();
+    minimize();
+    lbd = calc_lbd(&learnt[0], learnt.size());      // Calculate the LBD.
+    lbd_fast.update(lbd), lbd_slow.update(lbd > 50 ? 50 : lbd);    // update fast-slow.
     if (learnt.size() == 1) backtrackLevel = 0;
     else {                                           // find the second highest level for backtracking.
         int max_id = 1;
         for (int i = 2; i < (int)learnt.size(); i++)
-            if (level[abs(learnt[i])] > level[abs(learnt[max_id])]) max_id = i;
+            if (level(abs(learnt[i])) > level(abs(learnt[max_id]))) max_id = i;
         int p = learnt[max_id];
-        learnt[max_id] = learnt[1], learnt[1] = p, backtrackLevel = level[abs(p)];
+        learnt[max_id] = learnt[1], learnt[1] = p, backtrackLevel = level(abs(p));
     }
-    for (int i = 0; i < (int)bump.size(); i++)       // heuristically bump some variables.
-        if (level[bump[i]] >= backtrackLevel - 1) bump_var(bump[i], 1);
+    if (!stable) bump_queue(bumped);
+    else for (int i = 0; i < (int)bumped.size(); i++)    // heuristically bump some variables.
+        if (level(bumped[i]) >= backtrackLevel - 1) bump_var(bumped[i], 1);
+    if (learnt.size() > 1 && highestLevel - backtrackLevel > chrono_limit)
+        backtrackLevel = highestLevel - 1, ++chrono_backtracks;     // Keep the trail, the UIP is assigned out of order.
     return 0;
 }
 
+void Solver::minimize() {                           // Drop the literals implied by the others, then shrink each level to one literal.
+    uint64_t levels = 0;                            // Abstraction of the levels in the clause, other levels cannot be implied.
+    for (int i = 1; i < (int)learnt.size(); i++) levels |= 1ULL << (level(abs(learnt[i])) & 63);
+    int k = 1;
+    for (int i = 1; i < (int)learnt.size(); i++)
+        if (!redundant(abs(learnt[i]), levels, 0)) learnt[k++] = learnt[i];
+    minimized_literals += learnt.size() - k;
+    learnt.resize(k);
+    std::sort(learnt.begin() + 1, learnt.end(), [&](int a, int b) { return level(abs(a)) > level(abs(b)); });
+    k = 1;
+    for (int i = 1, j; i < (int)learnt.size(); i = j) {
+        for (j = i + 1; j < (int)learnt.size() && level(abs(learnt[j])) == level(abs(learnt[i])); j++);
+        int lit = j - i > 1 ? shrink(&learnt[i], j - i, levels) : 0;
+        if (lit) learnt[k++] = lit, shrunk_literals += j - i - 1;
+        else while (i < j) learnt[k++] = learnt[i++];
+    }
+    learnt.resize(k);
+}
+
+bool Solver::redundant(int var, uint64_t levels, int depth) {   // Whether the reasons of var lead to the clause only.
+    if (depth && (mark[var] == time_stamp || !level(var))) return true;
+    int r = reason(var), n, *lits;
+    if (r == -1 || mark[var] == -time_stamp || depth > 1000 || !(levels >> (level(var) & 63) & 1)) return false;
+    if (r >= 0) n = clause_DB[r].size, lits = &clause_DB[r][0];
+    else n = xor_reasons[-2 - r], lits = &xor_reasons[-1 - r];     // Implied by a row, its variables are enough.
+    for (int i = 0; i < n; i++) {
+        int u = abs(lits[i]);
+        if (u != var && !redundant(u, levels, depth + 1)) {
+            if (depth) mark[var] = -time_stamp;     // Poisoned for the rest of this conflict.
+            return false;
+        }
+    }
+    if (depth) mark[var] = time_stamp;
+    return true;
+}
+
+int Solver::shrink(int *lits, int n, uint64_t levels) {
+    int l = level(abs(lits[0])), open = n, uip = 0; // Walk the level back until one literal implies all of them.
+    shrink_stack.clear();
+    for (int i = 0; i < n; i++) shrinking[abs(lits[i])] = 1, shrink_stack.push_back(abs(lits[i]));
+    for (int i = pos_in_trail[l] - 1; i >= pos_in_trail[l - 1]; i--) {
+        int var = abs(trail[i]), r = reason(var), m, *rs;
+        if (!shrinking[var]) continue;
+        if (open == 1) { uip = r == -1 ? 0 : -trail[i]; break; }   // Not to the decision, such clauses learn little.
+        if (r == -1) break;                         // Literals assigned out of order were not reached.
+        if (r >= 0) m = clause_DB[r].size, rs = &clause_DB[r][0];
+        else m = xor_reasons[-2 - r], rs = &xor_reasons[-1 - r];
+        bool ok = true;
+        for (int j = 0; j < m && ok; j++) {
+            int u = abs(rs[j]);
+            if (u == var || shrinking[u]) continue;
+            if (level(u) == l) shrinking[u] = 1, shrink_stack.push_back(u), open++;
+            else ok = redundant(u, levels, 1);
+        }
+        if (!ok) break;
+        open--;
+    }
+    for (int i = 0; i < (int)shrink_stack.size(); i++) shrinking[shrink_stack[i]] = 0;
+    return uip;
+}
+
+void Solver::strengthen_reason(int cref) {          // On-the-fly: drop the implied literal c[0] from a reason.
+    Clause &c = clause_DB[cref];
+    if (proof) proof->add(&c[1], c.size - 1), proof->remove(&c[0], c.size);
+    for (int w = 0; w < 2; w++) {
+        std::vector<Watcher> &ws = watch(-c[w]);
+        for (int j = 0; j < (int)ws.size(); j++)
+            if ((int)ws[j].idx_clause == cref) { ws.erase(ws.begin() + j); break; }
+    }
+    c[0] = c[--c.size], ++clause_DB.wasted, ++strengthened_reasons;
+    for (int w = 0; w < 2; w++) {                   // Watch the highest levels, they are unassigned by the backjump.
+        int best = w;
+        for (int i = w + 1; i < c.size; i++) if (level(abs(c[i])) > level(abs(c[best]))) best = i;
+        std::swap(c[w], c[best]);
+    }
+    attach(cref);
+}
+
+void Solver::missed_implication(int cref, int forced) {
+    Clause &c = clause_DB[cref];                    // Only c[forced] is on the highest level, the clause was unit below it.
+    backtrack(level(abs(c[forced])) - 1);
+    watch_at(cref, forced, 0);
+    int second = 1;
+    for (int i = 2; i < c.size; i++)
+        if (level(abs(c[i])) > level(abs(c[second]))) second = i;
+    watch_at(cref, second, 1);
+    assign(c[0], level(abs(c[1])), cref), ++chrono_backtracks;
+}
+
+void Solver::watch_at(int cref, int i, int w) {
+    Clause &c = clause_DB[cref];
+    if (i == w) return;
+    if (i < 2) { std::swap(c[0], c[1]); return; }   // Both are watched already.
+    std::vector<Watcher> &ws = watch(-c[w]);
+    for (int j = 0; j < (int)ws.size(); j++)
+        if ((int)ws[j].idx_clause == cref) { ws.erase(ws.begin() + j); break; }
+    std::swap(c[i], c[w]);
+    watch(-c[w]).push_back(Watcher(cref, c[1 - w]));
+}
+
+int Solver::calc_lbd(int *lits, int size) {
+    int lbd = 0;
+    ++lbd_stamp;
+    for (int i = 0; i < size; i++) {
+        int l = level(abs(lits[i]));
+        if (l && lbd_mark[l] != lbd_stamp) 
+            lbd_mark[l] = lbd_stamp, ++lbd;
+    }
+    return lbd;
+}
+
+void Solver::update_learnt(Clause &c) {
+    c.touched = conflicts;
+    if (c.tier == Clause::CORE) return;
+    int lbd = calc_lbd(&c[0], c.size);                  // Dynamic LBD, and promote the clause when it improves.
+    if (lbd >= (int)c.lbd) return;
+    c.lbd = lbd;
+    if (lbd <= core_lbd && !c.xor_row) c.tier = Clause::CORE;
+    else if (lbd <= tier2_lbd) c.tier = Clause::TIER2;
+}
+
 void Solver::backtrack(int backtrackLevel) {
     if ((int)pos_in_trail.size() <= backtrackLevel) return;
-    for (int i = trail.size() - 1; i >= pos_in_trail[backtrackLevel]; i--) {
+    int start = pos_in_trail[backtrackLevel], kept = start;
+    for (int i = trail.size() - 1; i >= start; i--) {
         int v = abs(trail[i]);
-        value[v] = 0, saved[v] = trail[i] > 0 ? 1 : -1; // phase saving 
-        if (!vsids.inHeap(v)) vsids.insert(v);          // update heap
+        if (level(v) <= backtrackLevel) { kept++; continue; }   // Assigned out of order, it stays.
+        value(v) = value(-v) = 0, saved[v] = trail[i] > 0 ? 1 : -1; // phase saving 
+        if (gauss.rows && column[v] >= 0) gauss_dirty = true;
+        if (!stable) vmtf.unassigned(v);                // update queue
+        else if (!vsids.inHeap(v)) vsids.insert(v);     // update heap
     }
-    propagated = pos_in_trail[backtrackLevel];
-    trail.resize(propagated);
+    if (kept > start)                               // Compact the kept literals, they are propagated again.
+        for (int i = start, j = start; j < kept; i++)
+            if (value(trail[i]) == 1) trail[j++] = trail[i];
+    propagated = std::min(propagated, start);
+    trail.resize(kept);
     pos_in_trail.resize(backtrackLevel);
+    if ((int)xor_reasons.size() > xor_compact) compact_xor_reasons();
 }
 
 int Solver::decide() {      
-    int next = -1;
-    while (next == -1 || value(next) != 0) {    // Picking a variable according to VSIDS
-        if (vsids.empty()) return 10;
-        else next = vsids.pop();
+    int next = 0;
+    while (!next && pos_in_trail.size() < assumptions.size()) {   // Assumptions are the first decisions.
+        int p = assumptions[pos_in_trail.size()];
+        if (value(p) == 1) pos_in_trail.push_back(trail.size());   // Already true, keep an empty level.
+        else if (value(p) == -1) return analyze_final(p), 20;
+        else next = p;
+    }
+    while (!next) {                             // Picking a variable according to VSIDS or VMTF
+        int var;
+        if (stable) {
+            if (vsids.empty()) return 10;
+            var = vsids.pop();
+        }
+        else if (!(var = vmtf.search)) return 10;
+        else vmtf.search = vmtf.links[var].prev;
+        if (value(var) == 0 && !eliminated[var]) next = saved[var] ? var * saved[var] : var;   // Pick the polarity of the varible
     }
     pos_in_trail.push_back(trail.size());
-    if (saved[next]) next *= saved[next];       // Pick the polarity of the varible
-    assign(next, pos_in_trail.size(), -1);
+    assign(next, pos_in_trail.size(), -1), ++decisions;
     return 0;
 }
 
+void Solver::analyze_final(int p) {
+    core.assign(1, p);
+    if (level(abs(p)) == 0) return;
+    mark[abs(p)] = ++time_stamp;
+    for (int i = trail.size() - 1; i >= pos_in_trail[0]; i--) {   // Walk back over the assumption levels.
+        int var = abs(trail[i]);
+        if (mark[var] != time_stamp) continue;
+        if (reason(var) == -1) { core.push_back(trail[i]); continue; }
+        Clause &c = clause_DB[reason(var) < -1 ? xor_reason(var) : reason(var)];
+        for (int j = 0; j < c.size; j++)
+            if (level(abs(c[j])) > 0) mark[abs(c[j])] = time_stamp;
+    }
+}
+
 void Solver::restart() {
-    fast_lbd_sum = lbd_queue_size = lbd_queue_pos = 0;
-    backtrack(0);
-    int phase_rand = rand() % 100;              // probabilistic rephasing
+    restarts = 0, ++restart_count;
+    if (stable && (luby_u & -luby_u) == luby_v) luby_u++, luby_v = 1;   // Reluctant doubling.
+    else if (stable) luby_v *= 2;
+    int reuse = reuse_trail();
+    reused_levels += reuse - std::min((int)assumptions.size(), reuse);
+    backtrack(reuse);
+    int phase_rand = random(100);               // probabilistic rephasing
     if ((phase_rand -= 60) < 0)     for (int i = 1; i <= vars; i++) saved[i] = local_best[i];
     else if ((phase_rand -= 5) < 0) for (int i = 1; i <= vars; i++) saved[i] = -local_best[i];
-    else if ((phase_rand -= 20) < 0)for (int i = 1; i <= vars; i++) saved[i] = rand() % 2 ? 1 : -1;
+    else if ((phase_rand -= 20) < 0)for (int i = 1; i <= vars; i++) saved[i] = random(2) ? 1 : -1;
+}
+
+int Solver::reuse_trail() {
+    int next = 0, keep = std::min(assumptions.size(), pos_in_trail.size());
+    if (exchange) return 0;                         // Imported clauses are simplified at level 0.
+    if (stable) {                                   // The variable the next decision would pick.
+        while (!vsids.empty() && (value(vsids.top()) != 0 || eliminated[vsids.top()])) vsids.pop();
+        if (!vsids.empty()) next = vsids.top();
+    }
+    else for (next = vmtf.search; next && (value(next) != 0 || eliminated[next]); next = vmtf.links[next].prev);
+    if (!next) return pos_in_trail.size();
+    while (keep < (int)pos_in_trail.size()) {       // Keep the levels whose decisions would be taken again.
+        int d = abs(trail[pos_in_trail[keep]]);
+        if (stable ? activity[d] <= activity[next] : vmtf.stamp[d] <= vmtf.stamp[next]) break;
+        keep++;
+    }
+    return keep;
 }
 
-void Solver::rephase() {
+bool Solver::restart_due() {
+    if (stable) return restarts >= luby_v * restart_unit;
+    return restarts >= 50 && restart_margin * lbd_fast.average() > lbd_slow.average();
+}
+
+void Solver::switch_mode() {
+    backtrack(0);
+    stable = !stable, ++mode_switches, restarts = 0;
+    if (!stable) mode_length *= 2;                  // Both modes get the same number of conflicts, doubled every round.
+    mode_limit = conflicts + mode_length;
+    if (stable) {
+        luby_u = luby_v = 1;
+        for (int i = 1; i <= vars; i++)             // The heap missed the variables unassigned in focused mode.
+            if (!vsids.inHeap(i) && value(i) == 0 && !eliminated[i]) vsids.insert(i);
+    }
+    else vmtf.search = vmtf.last;
+}
+
+void Solver::bump_queue(std::vector<int> &bump) {
+    std::sort(bump.begin(), bump.end(), [&](int a, int b) { return vmtf.stamp[a] < vmtf.stamp[b]; });
+    for (int i = 0; i < (int)bump.size(); i++) vmtf.bump(bump[i]);     // Keep their relative order.
+}
+
+int Solver::rephase() {
     rephases = 0, threshold *= 0.9, rephase_limit += 8192;
+    return walk_effort > 0 ? walk() : 0;
 }
 
 void Solver::reduce() {
-    backtrack(0);
     reduces = 0, reduce_limit += 512;
-    int new_size = origin_clauses, old_size = clause_DB.size();
-    reduce_map.resize(old_size);
-    for (int i = origin_clauses; i < old_size; i++) {    // random delete 50% bad clauses (LBD>=5)
-        if (clause_DB[i].lbd >= 5 && rand() % 2 == 0) reduce_map[i] = -1;  // remove clause
-        else {
-            if (new_size != i) clause_DB[new_size] = clause_DB[i];
-            reduce_map[i] = new_size++;
-        }
+    reduce_buffer.clear();
+    for (int i = 0; i < (int)learnt_DB.size(); i++) {
+        Clause &c = clause_DB[learnt_DB[i]];
+        if (c.tier == Clause::TIER2 && conflicts - c.touched > 2 * reduce_limit) c.tier = Clause::LOCAL;  // demote unused clauses
+        if (c.tier == Clause::LOCAL && !locked(learnt_DB[i])) reduce_buffer.push_back(learnt_DB[i]);
+    }
+    std::sort(reduce_buffer.begin(), reduce_buffer.end(), [&](int a, int b) {   // least recently used first
+        Clause &x = clause_DB[a], &y = clause_DB[b];
+        return x.touched != y.touched ? x.touched < y.touched : x.lbd > y.lbd; });
+    for (int i = 0; i < (int)reduce_buffer.size() / 2; i++) {
+        Clause &c = clause_DB[reduce_buffer[i]];
+        if (proof) proof->remove(&c[0], c.size);
+        clause_DB.free(reduce_buffer[i]);
+    }
+    int new_size = 0;
+    for (int i = 0; i < (int)learnt_DB.size(); i++)
+        if (!clause_DB[learnt_DB[i]].deleted) learnt_DB[new_size++] = learnt_DB[i];
+    learnt_DB.resize(new_size);
+    garbage_collect();
+    if (verbosity > 0) report_tiers();
+}
+
+bool Solver::locked(int cref) {
+    Clause &c = clause_DB[cref];                    // Binary clauses are not reordered, either literal may be implied.
+    return (value(c[0]) == 1 && reason(abs(c[0])) == cref) || (value(c[1]) == 1 && reason(abs(c[1])) == cref);
+}
+
+void Solver::report_tiers() {
+    int count[3] = {0, 0, 0};
+    long long bytes[3] = {0, 0, 0};
+    for (int i = 0; i < (int)learnt_DB.size(); i++) {
+        Clause &c = clause_DB[learnt_DB[i]];
+        count[c.tier]++, bytes[c.tier] += (ClauseArena::header + c.size) * sizeof(int);
     }
-    clause_DB.resize(new_size, Clause(0));
-    for (int v = -vars; v <= vars; v++) {   // Update the watches.
+    printf("c reduce at %d conflicts: core %d (%.1f MB), tier2 %d (%.1f MB), local %d (%.1f MB), arena %.1f MB\n",
+        conflicts, count[0], bytes[0] / 1048576.0, count[1], bytes[1] / 1048576.0, count[2], bytes[2] / 1048576.0,
+        clause_DB.memory.size() * sizeof(int) / 1048576.0);
+}
+
+void Solver::garbage_collect() {
+    ClauseArena to;
+    to.memory.reserve(clause_DB.memory.size() - clause_DB.wasted);
+    for (int v = -vars; v <= vars; v++) {   // Move the clauses in watching order and update the watches.
         if (v == 0) continue;
-        int old_sz = watch(v).size(), new_sz = 0;
+        std::vector<Watcher> &ws = watch(v);
+        int old_sz = ws.size(), new_sz = 0;
         for (int i = 0; i < old_sz; i++) {
-            int old_idx = watch(v)[i].idx_clause;
-            int new_idx = old_idx < origin_clauses ? old_idx : reduce_map[old_idx];
-            if (new_idx != -1) {
-                watch(v)[i].idx_clause = new_idx;
-                if (new_sz != i) watch(v)[new_sz] = watch(v)[i];
-                new_sz++;
-            }
+            if (clause_DB[ws[i].idx_clause].deleted) continue;
+            ws[i].idx_clause = clause_DB.relocate(ws[i].idx_clause, to);
+            ws[new_sz++] = ws[i];
         }
-        watch(v).resize(new_sz);
+        ws.resize(new_sz);
+    }
+    for (int i = 0; i < (int)trail.size(); i++) {      // Update the reasons of assigned variables.
+        int &r = reason(abs(trail[i]));
+        if (r >= 0) r = clause_DB[r].deleted ? -1 : clause_DB.relocate(r, to);
+    }
+    for (int i = 0; i < (int)origin_DB.size(); i++) origin_DB[i] = clause_DB.relocate(origin_DB[i], to);
+    for (int i = 0; i < (int)learnt_DB.size(); i++) learnt_DB[i] = clause_DB.relocate(learnt_DB[i], to);
+    clause_DB.memory.swap(to.memory), clause_DB.wasted = 0;
+    sort_watches();
+}
+
+void Solver::sort_watches() {
+    for (int v = -vars; v <= vars; v++) {   // Binary watchers first, they never need the clause memory.
+        if (v == 0) continue;
+        std::stable_partition(watch(v).begin(), watch(v).end(), [](const Watcher &w) { return w.binary; });
     }
 }
 
-int Solver::solve() {
+int Solver::solve(const std::vector<int> &assumps) {
+    assumptions = assumps, core.clear(), model.clear();
+    if (!ok) return 20;
+    for (int i = 0; i < (int)assumptions.size(); i++)
+        freeze(abs(assumptions[i]));                    // Assumed variables are never replaced, a replaced one comes back.
+    if (!ok) return 20;
+    if (lbd_mark.size() < vars + assumptions.size() + 1)   // A true assumption keeps an empty level, so levels may exceed vars.
+        lbd_mark.resize(vars + assumptions.size() + 1, 0);
     int res = 0;
+    solve_start = wall_clock(), solve_conflicts = conflicts, check_point = conflicts;
     while (!res) {
+        if (exchange && exchange->stop.load(std::memory_order_relaxed)) break;     // Another solver has finished.
+        if (interrupted.load(std::memory_order_relaxed)) break;
+        bool timed = !(++propagate_calls & 63);         // The clock costs as much as a short propagation, so sample it.
+        double t = timed ? wall_clock() : 0;
         int cref = propagate();                         // Boolean Constraint Propagation (BCP)
+        if (timed) propagate_time += 64 * (wall_clock() - t);
         if (cref != -1) {                               // Find a conflict
+            if (conflicts >= check_point && out_of_budget()) break;
             int backtrackLevel = 0, lbd = 0;
+            t = wall_clock();
             res = analyze(cref, backtrackLevel, lbd);   // Conflict analyze
-            if (res == 20) break;                       // Find a conflict in 0-level
+            analyze_time += wall_clock() - t;
+            if (res == 20) { ok = false; break; }       // Find a conflict in 0-level
+            if (learnt.empty()) continue;               // A missed implication was assigned instead.
+            if (proof) proof->add(learnt);
+            learnt_literals += learnt.size(), ++learnt_clauses;
             backtrack(backtrackLevel);                  // backtracking         
+            if (exchange && lbd <= share_lbd) share_out(learnt, lbd);
             if (learnt.size() == 1) assign(learnt[0], 0, -1);   // Learnt a unit clause.
             else {                     
-                int cref = add_clause(learnt);                  // Add a clause to data base.
-                clause_DB[cref].lbd = lbd;              
-                assign(learnt[0], backtrackLevel, cref);        // The learnt clause implies the assignment of the UIP variable.
+                int cref = add_learnt(learnt, lbd);             // Add a clause to data base.
+                assign(learnt[0], level(abs(learnt[1])), cref); // The learnt clause implies the assignment of the UIP variable.
             }
-            var_inc *= (1 / 0.8);                               // var_decay for locality
+            if (stable) var_inc *= (1 / 0.8);                   // var_decay for locality
             ++restarts, ++conflicts, ++rephases, ++reduces;     
             if ((int)trail.size() > threshold) {                // update the local-best phase
                 threshold = trail.size();                       
-                for (int i = 1; i <= vars; i++) local_best[i] = value[i];
+                for (int i = 1; i <= vars; i++) local_best[i] = value(i);
             }
         }
-        else if (reduces >= reduce_limit) reduce();            
-        else if (lbd_queue_size == 50 && 0.8 * fast_lbd_sum / lbd_queue_size > slow_lbd_sum / conflicts) restart(); 
-        else if (rephases >= rephase_limit) rephase();
+        else if (reduces >= reduce_limit) {
+            t = wall_clock(), reduce();
+            reduce_time += wall_clock() - t;
+        }
+        else if (conflicts >= mode_limit) switch_mode();
+        else if (inprocess_effort > 0 && conflicts >= inprocess_limit) {
+            if ((res = inprocess()) == 20) ok = false;
+        }
+        else if (restart_due()) {
+            restart();
+            if (exchange && (res = share_in()) == 20) ok = false;
+        }
+        else if (rephases >= rephase_limit) {
+            t = wall_clock(), res = rephase();
+            walk_time += wall_clock() - t;
+        }
         else res = decide();
     }
+    if (res == 10) extend_model();
+    backtrack(0);
     return res;
 }
 
 void Solver::printModel() {
     printf("v ");
-    for (int i = 1; i <= vars; i++) printf("%d ", value[i] * i);
+    for (int i = 1; i <= vars; i++) printf("%d ", model[i] * i);
     puts("0");
 }
 
-int main(int argc, char **argv) {
-    Solver S;
-    int res = S.parse(argv[1]);
-    if (res == 20) printf("s UNSATISFIABLE\n");
-    else {
-        res = S.solve();
-        if (res == 10) {
-            printf("s SATISFIABLE\n");
-            S.printModel();
+void Solver::diversify(int id) {
+    share_id = id, rng += 0x9E3779B97F4A7C15ULL * id;      // Distinct streams derived from the seed.
+    if (id == 0) return;                                    // The first member keeps the default configuration.
+    stable = id % 2;                                        // Half of the members start in stable mode.
+    restart_margin = 0.75 + 0.05 * (id % 4);
+    rephase_limit = 1024 << (id % 3);
+    for (int i = 1; i <= vars; i++)                         // Different initial phases.
+        saved[i] = id % 3 == 1 ? -1 : id % 3 == 2 ? 1 : (random(2) ? 1 : -1);
+}
+
+bool Solver::out_of_budget() {
+    check_point = conflicts + 256;                          // Look at the clock every 256 conflicts.
+    if (conflict_limit > 0) {
+        if (conflicts - solve_conflicts >= conflict_limit) return true;
+        check_point = std::min(check_point, solve_conflicts + conflict_limit);
+    }
+    double now = wall_clock();
+    if (report_interval > 0 && now - report_time >= report_interval) report_time = now, print_progress();
+    if (time_limit > 0 && now - solve_start >= time_limit) return true;
+    return memory_limit > 0 && memory_used() >= memory_limit * 1048576LL;
+}
+
+bool Solver::over_limits(long long work) {                 // work counts ticks or propagations from 0 in each loop.
+    if (limit_mark < 0 || work < limit_mark) return limit_mark < 0;
+    bool stop = interrupted.load(std::memory_order_relaxed) || (exchange && exchange->stop.load(std::memory_order_relaxed));
+    stop = stop || (time_limit > 0 && wall_clock() - solve_start >= time_limit);
+    stop = stop || (memory_limit > 0 && memory_used() >= memory_limit * 1048576LL);
+    limit_mark = stop ? -1 : work + (1 << 20);
+    return stop;
+}
+
+long long Solver::memory_used() {                          // Bytes in use by this instance, unlike the process peak it can go down.
+    long long bytes = clause_DB.memory.size() * sizeof(int) + (2 * vars + 1) * sizeof(watches[0]);
+    for (int i = 0; i < 2 * vars + 1; i++) bytes += watches[i].size() * sizeof(Watcher);
+    for (int i = 0; i < (int)occurs.size(); i++) bytes += occurs[i].size() * sizeof(int);
+    bytes += (vars + 1) * (2 + sizeof(VarData) + sizeof(double) + 5 * sizeof(int));     // value, vardata, activity, mark, ...
+    bytes += (trail.size() + origin_DB.size() + learnt_DB.size() + elim_stack.size() + xor_reasons.size()) * sizeof(int);
+    return bytes + gauss.bits.size() * sizeof(uint64_t);
+}
+
+void Solver::print_progress() {
+    static bool header = false;
+    if (!header) {
+        header = true;
+        printf("c %4s %9s %10s %11s %12s %8s %8s %8s %7s\n", "mode", "seconds", "conflicts", "decisions", "props/s", "learnts", "avg size", "level-0", "MB");
+    }
+    double elapsed = wall_clock() - start_time;
+    printf("c %4s %9.1f %10d %11lld %12.0f %8d %8.1f %8d %7.1f\n", stable ? "S" : "F", elapsed, conflicts, decisions,
+        propagations / std::max(elapsed, 1e-3), (int)learnt_DB.size(), (double)learnt_literals / std::max(learnt_clauses, 1LL),
+        pos_in_trail.empty() ? (int)trail.size() : pos_in_trail[0], peak_memory() / 1024.0);
+    fflush(stdout);
+}
+
+void Solver::print_stats() {
+    double elapsed = std::max(wall_clock() - start_time, 1e-3);
+    printf("c conflicts: %d, propagations: %lld\n", conflicts, propagations);
+    printf("c decisions: %lld, mode switches: %d\n", decisions, mode_switches);
+    printf("c restarts: %lld (%.1f levels reused), chronological backtracks: %lld\n", restart_count,
+        (double)reused_levels / std::max(restart_count, 1LL), chrono_backtracks);
+    printf("c local search: %d walks, %lld flips\n", walks, walk_flips);
+    printf("c gauss: %d XORs, %d x %d matrix, %lld propagations, %lld conflicts, %lld pivots\n",
+        xor_found, gauss.rows, gauss.cols, gauss_props, gauss_conflicts, gauss_pivots);
+    printf("c inprocess: %d rounds, %d failed literals, %d substituted, %d vivified (%lld literals removed)\n",
+        inprocessings, inprocess_failed, substituted, vivified, vivify_removed);
+    if (proof) printf("c proof: %lld added, %lld deleted, %.1f MB\n", proof->added, proof->deleted, proof->bytes / 1048576.0);
+    printf("c learnt literals: %lld (%.1f per clause, %.1f before minimization)\n", learnt_literals,
+        (double)learnt_literals / std::max(learnt_clauses, 1LL), (double)learnt_uip_literals / std::max(learnt_clauses, 1LL));
+    printf("c minimize: %lld literals removed, %lld by shrinking, %lld reasons strengthened\n", minimized_literals, shrunk_literals, strengthened_reasons);
+    printf("c speed: %.0f conflicts/s, %.0f propagations/s\n", conflicts / elapsed, propagations / elapsed);
+    printf("c time: %.2fs total, %.2fs propagate, %.2fs analyze, %.2fs reduce, %.2fs walk\n", elapsed, propagate_time, analyze_time, reduce_time, walk_time);
+    printf("c inprocess time: %.2fs probe, %.2fs substitute, %.2fs vivify\n", probe_time, substitute_time, vivify_time);
+    printf("c peak memory: %.1f MB\n", peak_memory() / 1024.0);
+    fflush(stdout);
+}
+
+void Solver::share_out(std::vector<int> &c, int lbd) {
+    exchange->rings[share_id]->push(c, lbd);
+}
+
+int Solver::share_in() {
+    share_cursor.resize(exchange->rings.size(), 0);
+    int lbd;
+    for (int r = 0; r < (int)exchange->rings.size(); r++) {
+        if (r == share_id) continue;
+        while (exchange->rings[r]->pull(share_cursor[r], share_buffer, lbd)) {
+            int sz = 0; bool sat = false;
+            for (int i = 0; i < (int)share_buffer.size() && !sat; i++) {  // Simplify under the level 0 assignment.
+                int lit = share_buffer[i];
+                if (value(lit) == 1 || eliminated[abs(lit)]) sat = true;   // Substituted variables are not watched any more.
+                else if (value(lit) == 0) share_buffer[sz++] = lit;
+            }
+            if (sat) continue;
+            if (sz == 0) return 20;                         // Others have refuted the formula.
+            share_buffer.resize(sz);
+            if (sz == 1) assign(share_buffer[0], 0, -1);
+            else add_learnt(share_buffer, lbd);
         }
-        else if (res == 20) printf("s UNSATISFIABLE\n");
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -24,72 +24,266 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 ************************************************************************************/
 
+#pragma once
 #include "heap.hpp"
+#include "queue.hpp"
+#include "share.hpp"
+#include "proof.hpp"
+#include "gauss.hpp"
+#include <string>
+#include <cstdint>
 
-class Clause {
+struct ParseChunk;              // A block of parsed literals, see parse.cpp.
+
+class Clause {                  // Stored inline in the ClauseArena, literals follow the header.
+public:
+    enum { CORE, TIER2, LOCAL };// Tiers of learnt clauses, from kept forever to reduced by recent use.
+    int size;                   // The number of literals in this clause.
+    unsigned lbd : 26,          // Literal Block Distance (Gilles & Laurent, IJCAI 2009)
+             tier : 2,          // The tier of a learnt clause.
+             learnt : 1,        // Whether this clause is a learnt clause.
+             xor_row : 1,       // Whether a learnt clause was built from the XOR rows, it never enters the core tier.
+             deleted : 1,       // Whether this clause waits to be collected.
+             reloced : 1;       // Whether this clause has been moved, c[0] is the new reference.
+    int touched;                // The last conflict a learnt clause took part in.
+    int& operator [] (int index) { return ((int *)(this + 1))[index]; }
+};
+
+class ClauseArena {             // Contiguous clause memory, a clause reference is the offset of its header.
 public:
-    int lbd;                    // Literal Block Distance (Gilles & Laurent, IJCAI 2009)
-    std::vector<int> lit;       // Literals in this clause
-    Clause(int sz): lbd(0) { lit.resize(sz); }
-    int& operator [] (int index) { return lit[index]; }
+    enum { header = sizeof(Clause) / sizeof(int) };
+    std::vector<int> memory;    // Clause headers and literals.
+    int wasted;                 // The number of ints occupied by deleted clauses.
+    ClauseArena(): wasted(0) {}
+    Clause& operator [] (int cref) { return *(Clause *)&memory[cref]; }
+    int  alloc(const std::vector<int> &c, bool learnt);     // Append a clause and return its reference.
+    void free(int cref);                                    // Mark a clause as deleted.
+    int  relocate(int cref, ClauseArena &to);               // Move a clause into another arena.
 };
 
 class Watcher {
 public:
-    int idx_clause              // The clause index in clause database.
-        , blocker;              // Used to fast guess whether a clause is already satisfied. 
-    Watcher(): idx_clause(0), blocker(0) {}
-    Watcher(int c, int b): idx_clause(c), blocker(b) {}
+    unsigned idx_clause : 31,   // The clause reference in clause database.
+             binary : 1;        // Whether the clause is binary, then blocker is its other literal.
+    int blocker;                // Used to fast guess whether a clause is already satisfied. 
+    Watcher(): idx_clause(0), binary(0), blocker(0) {}
+    Watcher(int c, int b, bool bin = false): idx_clause(c), binary(bin), blocker(b) {}
+};
+
+struct VarData {                 // Read together in propagation and conflict analyzation.
+    int reason;                 // The index of the clause that implies the variable assignment.
+    int level;                  // The decision level of a variable.
+};
+
+struct EMA {                     // Exponential moving average, corrected for its start at 0.
+    double biased, decay, alpha;
+    EMA(double a = 0): biased(0), decay(1), alpha(a) {}
+    void update(double x) { biased += alpha * (x - biased), decay *= 1 - alpha; }
+    double average() const { return decay < 1 ? biased / (1 - decay) : 0; }
 };
 
 struct GreaterActivity {        // A compare function used to sort the activities.
-    const double *activity;     
-    bool operator() (int a, int b) const { return activity[a] > activity[b]; }
+    const std::vector<double> *activity;     
+    bool operator() (int a, int b) const { return (*activity)[a] > (*activity)[b]; }
     GreaterActivity(): activity(NULL) {}
-    GreaterActivity(const double *s): activity(s) {}
+    GreaterActivity(const std::vector<double> *s): activity(s) {}
 };
 
 class Solver {
 public:
-    std::vector<int>    learnt,                     // The clause indices of the learnt clauses.
+    std::vector<int>    learnt,                     // The literals of the clause being learnt.
+                        lbd_mark,                   // Aid for LBD calculation, indexed by level.
+                        reduce_buffer,              // Aid for clause management.
                         trail,                      // Save the assigned literal sequence.
                         pos_in_trail,               // Save the decision variables' position in trail.
-                        reduce_map;                 // Auxiliary data structure for clause management.
-    std::vector<Clause> clause_DB;                  // clause database.
-    std::vector<Watcher> *watches;                  // A mapping from literal to clauses.
-    int vars, clauses, origin_clauses, conflicts;   // the number of variables, clauses, conflicts.
+                        origin_DB,                  // The references of the original clauses.
+                        learnt_DB;                  // The references of the learnt clauses.
+    ClauseArena clause_DB;                          // clause database.
+    std::vector<std::vector<Watcher> > watches;     // A mapping from literal to clauses.
+    int vars, clauses, conflicts;                   // the number of variables, clauses, conflicts.
     int restarts, rephases, reduces;                // the number of conflicts since the last ... .
     int rephase_limit, reduce_limit;                // parameters for when to conduct rephase and reduce.
     int threshold;                                  // A threshold for updating the local_best phase.
     int propagated;                                 // The number of propagted literals in trail.
-    int time_stamp;                                 // Aid parameter for conflict analyzation and LBD calculation.   
+    long long propagations, decisions;              // The number of literals propagated and decisions made in total.
+    long long learnt_literals, learnt_clauses;      // The size of all learnt clauses (before they are reduced) and their number.
+    long long learnt_uip_literals;                  // The size of the learnt clauses before minimization.
+    long long minimized_literals, shrunk_literals;  // Literals removed by recursive minimization and by shrinking levels.
+    long long strengthened_reasons;                 // Reason clauses strengthened on the fly during conflict analyzation.
+    long long restart_count, reused_levels;         // Restarts in total, and the decision levels they kept.
+    long long chrono_backtracks;                    // Conflicts that backtracked chronologically instead of jumping.
+    int chrono_limit;                               // Backtrack chronologically when a jump would undo more levels.
+    double propagate_time, analyze_time, reduce_time, walk_time;    // Seconds spent in these procedures during search.
+    long long propagate_calls;                      // Calls of propagate() in search, one in 64 is timed.
+    double start_time, report_time;                 // When the solver was created and the last progress line was printed.
+    double time_limit, report_interval;             // Seconds per solve() call and between progress lines, 0 for none.
+    long long conflict_limit;                       // Conflicts per solve() call, 0 for none.
+    int memory_limit;                               // Memory held by this solver in MB, 0 for none.
+    long long check_point;                          // The number of conflicts at which limits are checked next.
+    double solve_start;                             // When the current solve() call started.
+    long long solve_conflicts;                      // The number of conflicts when the current solve() call started.
+    long long limit_mark;                           // The work at which over_limits() looks at the limits next, -1 once exceeded.
+    static std::atomic<bool> interrupted;           // Set from a signal handler, every solver stops with UNKNOWN.
+    int time_stamp;                                 // Aid parameter for conflict analyzation.
+    int lbd_stamp;                                  // Aid parameter for LBD calculation.
+    int core_lbd, tier2_lbd;                        // The largest LBDs of the core and the tier2 clauses.
+    int verbosity;                                  // Print statistics while solving when positive.
    
-    int lbd_queue[50],                              // circled queue saved the recent 50 LBDs.
-        lbd_queue_size,                             // The number of LBDs in this queue
-        lbd_queue_pos;                              // The position to save the next LBD.
-    double fast_lbd_sum, slow_lbd_sum;              // Sum of the Global and recent 50 LBDs.        
-    int *value,                                     // The variable assignement (1:True; -1:False; 0:Undefine) 
-        *reason,                                    // The index of the clause that implies the variable assignment.
-        *level,                                     // The decision level of a variable      
-        *mark,                                      // Aid for conflict analyzation.
-        *local_best,                                // A phase with a local deepest trail.                     
-        *saved;                                     // Phase saving.
-    double *activity;                               // The variables' score for VSIDS.   
+    EMA lbd_fast, lbd_slow;                         // Moving averages of the recent and of all LBDs.
+    std::vector<int8_t> value;                      // The literal assignment (1:True; -1:False; 0:Undefine), see value(lit).
+    std::vector<VarData> vardata;                   // The reason and decision level of each variable.
+    std::vector<int> mark,                          // Aid for conflict analyzation: the clause and its implied variables, -time_stamp when not implied.
+                     bumped,                        // The variables seen in conflict analyzation, to bump.
+                     shrink_stack,                  // The variables of the level being shrunk.
+                     local_best,                    // A phase with a local deepest trail.                     
+                     saved;                         // Phase saving.
+    std::vector<char> shrinking;                    // Whether a variable is on the level being shrunk.
+    std::vector<double> activity;                   // The variables' score for VSIDS.   
     double var_inc;                                 // Parameter for VSIDS.               
-    Heap<GreaterActivity> vsids;                    // Heap to select variable.
+    Heap<GreaterActivity, 4> vsids;                 // Heap to select variable in stable mode.
+    Queue vmtf;                                     // Queue to select variable in focused mode.
+    bool stable;                                    // Stable mode: VSIDS and Luby restarts; focused mode: VMTF and LBD restarts.
+    int mode_switches;                              // The number of switches between the two modes.
+    long long mode_limit, mode_length;              // The conflicts at which to switch, and the length of the next phase.
+    double restart_margin;                          // Restart when the recent LBDs exceed the global average by this factor.
+    int restart_unit;                               // Conflicts per Luby unit in stable mode.
+    long long luby_u, luby_v;                       // Reluctant doubling (Knuth), luby_v follows the Luby sequence.
+    unsigned long long rng;                         // State of the per-solver random generator (xorshift64*).
+    ClauseExchange *exchange;                       // Portfolio shared by several solvers, NULL when solving alone.
+    Proof *proof;                                   // DRAT proof of the clauses added and deleted, NULL when off.
+    int share_id, share_lbd;                        // Our ring in the exchange, and the largest LBD to export.
+    std::vector<unsigned long long> share_cursor;   // Read positions in the other solvers' rings.
+    std::vector<int> share_buffer;                  // Aid for importing clauses.
+    std::vector<int> model,                         // The full assignment when the result is SAT.
+                     elim_stack;                    // Clauses removed by elimination, saved for model reconstruction.
+    std::vector<char> eliminated,                   // Whether a variable has been eliminated by preprocessing.
+                      frozen;                       // Variables that preprocessing must keep (used by later queries).
+    std::vector<int> substitutes;                   // The literal an equivalent variable was replaced by, 0 if none.
+    std::vector<int> assumptions,                   // The literals assumed by the current solve() call.
+                     core,                          // The assumptions responsible for the last UNSAT answer.
+                     origin_buffer;                 // Aid for adding original clauses.
+    bool ok;                                        // False once the formula has been refuted at level 0.
+    std::vector<std::vector<int> > occurs;          // A mapping from literal to clauses during preprocessing.
+    std::vector<int> seen, subsume_queue;           // Aid for preprocessing.
+    long long ticks;                                // Work done by the current preprocessing technique.
+    int pre_effort;                                 // Scale of the preprocessing budgets, 0 disables preprocessing.
+    int pre_eliminated, pre_subsumed, pre_strengthened, pre_failed;   // Preprocessing statistics.
+    int walk_effort;                                // Local search ticks per search propagation at each rephase, 0 disables it.
+    int walks;                                      // The number of local search runs.
+    long long walk_flips, walk_propagations;        // Flips in total, and the propagations at the last run.
+    int inprocess_effort;                           // Scale of the inprocessing budgets, 0 disables inprocessing.
+    int inprocess_limit, inprocess_interval;        // The conflicts of the next round and the growing gap between rounds.
+    long long inprocess_propagations;               // Propagations at the last round, the budgets are shares of the ones since.
+    int probe_next, vivify_next;                    // Where the next round of probing and vivification starts.
+    int logged_units;                               // Level 0 literals already in the proof as unit clauses.
+    int inprocessings, inprocess_failed, substituted, vivified;   // Inprocessing statistics.
+    long long vivify_removed;                       // Literals removed by vivification.
+    double probe_time, substitute_time, vivify_time;    // Seconds spent in each inprocessing technique.
+    int xor_size;                                   // The longest XOR detected from clauses (at most 6), 0 disables Gaussian elimination.
+    std::vector<int> xors,                          // The detected XORs: size, right-hand side, variables.
+                     column,                        // The matrix column of each variable, -1 if none.
+                     xor_reasons,                   // The rows that implied literals: size, variables.
+                     gauss_queue,                   // The rows to check.
+                     xor_lits;                      // Aid for building clauses from rows.
+    Matrix gauss;                                   // The XORs in reduced row echelon form.
+    bool gauss_dirty;                               // Variables of the matrix were unassigned, every row is checked.
+    int xor_found, xor_compact;                     // The number of XORs, and the size at which xor_reasons is compacted.
+    long long gauss_props, gauss_conflicts, gauss_pivots;   // Gaussian elimination statistics.
+    std::vector<int> cube_order;                    // The variables to split on, the most frequent first.
+    int cube_refuted;                               // Branches closed by propagation while cubing.
+    long long lookaheads;                           // Literals propagated to rank the split variables.
+    int parse_threads;                              // Threads scanning a large CNF file, 0 for one per core.
+    std::string parse_error;                        // Why the last parse() returned -1.
+
+    Solver();
+    void reset();                                   // Forget the formula and every setting, the buffers keep their memory.
+    int random(int n) {                             // A random integer in [0, n).
+        rng ^= rng >> 12, rng ^= rng << 25, rng ^= rng >> 27;
+        return (rng * 2685821657736338717ULL >> 33) % n;
+    }
      
-    void alloc_memory();                                    // Allocate memory for EasySAT 
+    void alloc_memory();                                    // Grow the variable data to hold vars variables.
     void assign(int lit, int level, int cref);              // Assigned a variable.
     int  propagate();                                       // BCP
     void backtrack(int backtrack_level);                    // Backtracking
     int  analyze(int cref, int &backtrack_level, int &lbd); // Conflict analyzation.
-    int  parse(char *filename);                             // Read CNF file.
-    int  solve();                                           // Solving.
+    void minimize();                                        // shorten the learnt clause by the reasons of its literals.
+    bool redundant(int var, uint64_t levels, int depth);    // whether var is implied by the learnt clause.
+    int  shrink(int *lits, int n, uint64_t levels);         // a single literal implying the n literals of one level, 0 if none.
+    void strengthen_reason(int cref);                       // remove the implied literal from a reason the resolvent subsumes.
+    int  parse(char *filename);                             // Read CNF file (plain, gzip or xz, "-" for stdin), -1 on error.
+    int  parse(const char *begin, const char *end);         // Read a CNF held in memory, -1 on error.
+    int  add_chunk(ParseChunk &chunk, int &declared, std::vector<int> &buffer); // add the clauses of a parsed block.
+    int  finish_parse(std::vector<int> &buffer);            // check the end of the input and propagate the units.
+    int  solve(const std::vector<int> &assumps = std::vector<int>());  // Solving under assumptions.
     int  decide();                                          // Pick desicion variable.
     int  add_clause(std::vector<int> &c);                    // add new clause to clause database.
+    int  add_learnt(std::vector<int> &c, int lbd);          // add a learnt clause into its tier.
+    int  calc_lbd(int *lits, int size);                     // the number of decision levels in a clause.
+    void update_learnt(Clause &c);                          // refresh a learnt clause used in conflict analyzation.
+    void report_tiers();                                    // print the clause database usage.
+    void attach(int cref);                                  // watch the first two literals of a clause.
     void bump_var(int var, double mult);                     // update activity      
     void restart();                                         // do restart.                                      
+    int  reuse_trail();                                     // the level a restart keeps, the decisions above it would change.
+    void missed_implication(int cref, int forced);          // assign the only literal of a conflict on its highest level.
+    void watch_at(int cref, int i, int w);                  // move the i-th literal of a clause to the watched place w.
+    bool locked(int cref);                                  // whether a clause is the reason of an assignment.
+    bool restart_due();                                     // whether the restart policy of the mode asks for a restart.
+    void switch_mode();                                     // switch between stable and focused mode.
+    void bump_queue(std::vector<int> &bump);                // move the variables to the front of the VMTF queue.
     void reduce();                                          // do clause management.
-    void rephase();                                         // do rephase.
+    void garbage_collect();                                 // compact the clause arena.
+    void sort_watches();                                    // move binary watchers to the front.
+    int  rephase();                                         // do rephase, 10 if local search found a model.
+    int  walk();                                            // local search from the saved phases, 10 if it found a model.
     void printModel();                                      // print model when the result is SAT.
-};
\ No newline at end of file
+    void diversify(int id);                                 // set up the id-th member of a portfolio.
+    bool out_of_budget();                                   // check the limits and print progress, true to stop.
+    bool over_limits(long long work);                       // the time, memory and stop checks of the loops outside search.
+    void print_progress();                                  // print a progress line of the running search.
+    void print_stats();                                     // print the statistics so far.
+    long long memory_used();                                // the bytes of the clauses, watch lists and variable data in use.
+    void share_out(std::vector<int> &c, int lbd);           // export a learnt clause to the portfolio.
+    int  share_in();                                        // import the clauses learnt by others at level 0.
+    int  preprocess();                                      // simplify the original clauses before search.
+    int  probe(long long limit);                            // failed literal probing.
+    int  inprocess();                                       // simplify the clauses at level 0 during search.
+    int  substitute(long long limit);                       // replace equivalent literals found on binary clauses.
+    int  vivify(long long limit);                           // shorten clauses by propagating their negations.
+    void log_units();                                       // write the new level 0 literals to the proof.
+    int  find_xors();                                       // detect the XORs encoded by original clauses.
+    int  gauss_init();                                      // build the matrix of the XORs, 20 if they contradict.
+    int  gauss_propagate(int var);                          // check the rows of an assigned variable, a conflict or -1.
+    int  gauss_check();                                     // check the queued rows, a conflict or -1.
+    int  gauss_row(int r);                                  // pivot, propagate or find a conflict in a row.
+    int  xor_clause(std::vector<int> &c);                   // add a clause derived from the rows.
+    int  xor_reason(int var);                               // the reason clause of a literal implied by a row.
+    void compact_xor_reasons();                             // drop the rows of literals no longer assigned.
+    int  cube(int depth, std::vector<int> &cubes);          // split the formula into cubes, each ends with 0; 20 if all are refuted.
+    void split(int depth, std::vector<int> &prefix, std::vector<int> &cubes);  // write the cubes below the decisions in prefix.
+    int  lookahead();                                       // the variable to split on, 0 if none, -1 if the node is refuted.
+    int  subsume();                                         // subsumption and self-subsuming strengthening.
+    int  eliminate();                                       // bounded variable elimination.
+    int  occ_propagate();                                   // propagate level 0 units over the occurrence lists.
+    int  strengthen(int cref, int lit);                     // remove a literal from a clause during preprocessing.
+    int  subsume_with(int cref);                            // subsume or strengthen clauses by a clause.
+    bool subsumed(std::vector<int> &c);                     // forward subsumption check for a new clause.
+    bool resolve(int p, int n, int v, std::vector<int> &out);   // resolvent of two clauses on v, false if tautological.
+    void remove_clause(int cref);                           // delete a clause during preprocessing.
+    void extend_model();                                    // build the model including eliminated variables.
+    void analyze_final(int p);                              // collect the assumptions that falsify p.
+
+    // Library interface. Literals are DIMACS integers, clauses can be added between solve() calls
+    // and learnt clauses are kept. preprocess() eliminates variables, so call freeze() first on every
+    // variable that later clauses or assumptions will mention.
+    int  new_var();                                         // add a variable and return its index.
+    bool add_origin(const std::vector<int> &c);             // add an original clause, false if the formula became UNSAT.
+    void freeze(int var);                                   // keep var out of variable elimination.
+    void restore(int var);                                  // bring back a substituted variable used by a later query.
+    bool failed(int lit);                                   // whether an assumption is in the core of the last UNSAT answer.
+    int  model_value(int lit);                              // the value of lit in the last model (1:True; -1:False; 0:no model).
+};
+
+double wall_clock();                                        // Seconds from an arbitrary fixed point.
+long long peak_memory();                                    // Peak resident memory of the process in KB.
@@ -0,0 +1,252 @@
+// Benchmark runner: generates a fixed suite of instances, runs the solver on each one and
+// writes a JSON report, optionally compared against a stored baseline report.
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+struct Instance {
+    std::string name, expect;                       // expect is "" when the answer is not known in advance.
+    int vars;
+    std::vector<std::vector<int> > clauses;
+};
+
+struct Result {
+    std::string name, status;
+    double time;
+    long long conflicts, propagations, rss;         // rss: peak resident set size in KB.
+    bool wrong;                                     // A wrong answer or an invalid model.
+};
+
+unsigned long long rng;
+int random(int n) {                                 // The same xorshift64* generator as the solver.
+    rng ^= rng >> 12, rng ^= rng << 25, rng ^= rng >> 27;
+    return (rng * 2685821657736338717ULL >> 33) % n;
+}
+
+Instance random_ksat(int k, int n, double ratio, int id) {   // Uniform random k-SAT near the phase transition.
+    Instance I;
+    char name[64]; sprintf(name, "rand%d-%d-%d", k, n, id);
+    I.name = name, I.vars = n;
+    int m = (int)(ratio * n + 0.5);
+    for (int i = 0; i < m; i++) {
+        std::vector<int> c;
+        while ((int)c.size() < k) {
+            int v = random(n) + 1;
+            bool dup = false;
+            for (int j = 0; j < (int)c.size(); j++) dup |= abs(c[j]) == v;
+            if (!dup) c.push_back(random(2) ? v : -v);
+        }
+        I.clauses.push_back(c);
+    }
+    return I;
+}
+
+Instance pigeonhole(int n) {                        // n + 1 pigeons in n holes, unsatisfiable.
+    Instance I;
+    char name[64]; sprintf(name, "php-%d", n);
+    I.name = name, I.expect = "UNSATISFIABLE", I.vars = (n + 1) * n;
+    for (int i = 0; i <= n; i++) {                  // Every pigeon sits in a hole.
+        std::vector<int> c;
+        for (int j = 0; j < n; j++) c.push_back(i * n + j + 1);
+        I.clauses.push_back(c);
+    }
+    for (int j = 0; j < n; j++)                     // No two pigeons share a hole.
+        for (int a = 0; a <= n; a++)
+            for (int b = a + 1; b <= n; b++) I.clauses.push_back(std::vector<int>{-(a * n + j + 1), -(b * n + j + 1)});
+    return I;
+}
+
+void xor_gate(Instance &I, int o, int a, int b) {   // o = a xor b
+    I.clauses.push_back(std::vector<int>{-o, a, b});
+    I.clauses.push_back(std::vector<int>{-o, -a, -b});
+    I.clauses.push_back(std::vector<int>{o, -a, b});
+    I.clauses.push_back(std::vector<int>{o, a, -b});
+}
+
+Instance parity(int n) {                            // Two xor chains over different orders of the inputs differ, unsatisfiable.
+    Instance I;
+    char name[64]; sprintf(name, "parity-%d", n);
+    I.name = name, I.expect = "UNSATISFIABLE", I.vars = 3 * n;
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i + 1;
+    for (int i = n - 1; i > 0; i--) std::swap(order[i], order[random(i + 1)]);
+    int y = 1, z = order[0];                        // Inputs 1..n, chains n+1..2n and 2n+1..3n.
+    for (int i = 1; i < n; i++) {
+        xor_gate(I, n + i, y, i + 1), y = n + i;
+        xor_gate(I, 2 * n + i, z, order[i]), z = 2 * n + i;
+    }
+    I.clauses.push_back(std::vector<int>{y, z});
+    I.clauses.push_back(std::vector<int>{-y, -z});
+    return I;
+}
+
+std::vector<Instance> suite(int seed) {
+    std::vector<Instance> S;
+    rng = 0x9E3779B97F4A7C15ULL * (seed + 1);
+    for (int i = 0; i < 3; i++) S.push_back(random_ksat(3, 200 + 25 * i, 4.26, i));
+    S.push_back(random_ksat(4, 80, 9.93, 0));
+    S.push_back(random_ksat(5, 50, 21.12, 0));
+    for (int n = 8; n <= 9; n++) S.push_back(pigeonhole(n));
+    for (int n = 28; n <= 32; n += 2) S.push_back(parity(n));
+    return S;
+}
+
+void write_cnf(const Instance &I, const std::string &path) {
+    FILE *f = fopen(path.c_str(), "w");
+    fprintf(f, "p cnf %d %d\n", I.vars, (int)I.clauses.size());
+    for (int i = 0; i < (int)I.clauses.size(); i++) {
+        for (int j = 0; j < (int)I.clauses[i].size(); j++) fprintf(f, "%d ", I.clauses[i][j]);
+        fprintf(f, "0\n");
+    }
+    fclose(f);
+}
+
+Result run(const char *solver, const Instance &I, const std::string &path, int seed, int timeout) {
+    Result R;
+    R.name = I.name, R.status = "UNKNOWN", R.time = 0, R.conflicts = R.propagations = R.rss = 0, R.wrong = false;
+    int fd[2];
+    if (pipe(fd)) return R.status = "ERROR", R;
+    char seed_arg[32]; sprintf(seed_arg, "--seed=%d", seed);
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        struct rlimit lim = { (rlim_t)timeout, (rlim_t)timeout + 1 };
+        setrlimit(RLIMIT_CPU, &lim);
+        dup2(fd[1], 1), close(fd[0]), close(fd[1]);
+        execl(solver, solver, seed_arg, path.c_str(), (char *)NULL);
+        _exit(127);
+    }
+    close(fd[1]);
+    std::string out;
+    char buf[1 << 16];
+    for (ssize_t n; (n = read(fd[0], buf, sizeof(buf))) > 0; ) out.append(buf, n);
+    close(fd[0]);
+    int wstatus;
+    struct rusage ru;
+    wait4(pid, &wstatus, 0, &ru);
+    R.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    R.rss = ru.ru_maxrss;
+    if (WIFSIGNALED(wstatus)) R.status = WTERMSIG(wstatus) == SIGXCPU || WTERMSIG(wstatus) == SIGKILL ? "TIMEOUT" : "CRASH";
+    std::vector<int> model(I.vars + 1, 0);
+    for (size_t p = 0, q; p < out.size(); p = q + 1) {      // Parse the solver output line by line.
+        q = out.find('\n', p);
+        if (q == std::string::npos) q = out.size();
+        std::string line = out.substr(p, q - p);
+        if (!line.compare(0, 2, "s ")) R.status = line.substr(2);
+        else if (!line.compare(0, 13, "c conflicts: ")) sscanf(line.c_str(), "c conflicts: %lld, propagations: %lld", &R.conflicts, &R.propagations);
+        else if (!line.compare(0, 2, "v ")) {
+            char *s = &line[1], *e;
+            for (long lit; (lit = strtol(s, &e, 10)), e != s; s = e)
+                if (lit && labs(lit) <= I.vars) model[labs(lit)] = lit;
+        }
+    }
+    if (!I.expect.empty() && (R.status == "SATISFIABLE" || R.status == "UNSATISFIABLE")) R.wrong = R.status != I.expect;
+    if (R.status == "SATISFIABLE")                  // Check the model against every clause.
+        for (int i = 0; i < (int)I.clauses.size() && !R.wrong; i++) {
+            bool sat = false;
+            for (int j = 0; j < (int)I.clauses[i].size(); j++) sat |= model[abs(I.clauses[i][j])] == I.clauses[i][j];
+            R.wrong = !sat;
+        }
+    return R;
+}
+
+bool read_baseline(const char *path, std::vector<Result> &base) {    // Read the instance lines of a report written by write_report.
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char line[1024], name[256], status[64];
+    while (fgets(line, sizeof(line), f)) {
+        Result R;
+        if (sscanf(line, " {\"name\": \"%255[^\"]\", \"status\": \"%63[^\"]\", \"time\": %lf, \"conflicts\": %lld, \"propagations\": %lld",
+                   name, status, &R.time, &R.conflicts, &R.propagations) != 5) continue;
+        R.name = name, R.status = status;
+        base.push_back(R);
+    }
+    fclose(f);
+    return true;
+}
+
+void write_report(const char *path, const char *solver, int seed, const std::vector<Result> &results) {
+    FILE *f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return; }
+    double total = 0;
+    fprintf(f, "{\n  \"solver\": \"%s\",\n  \"seed\": %d,\n  \"instances\": [\n", solver, seed);
+    for (int i = 0; i < (int)results.size(); i++) {
+        const Result &R = results[i];
+        double t = std::max(R.time, 1e-6);
+        total += R.time;
+        fprintf(f, "    {\"name\": \"%s\", \"status\": \"%s\", \"time\": %.3f, \"conflicts\": %lld, \"propagations\": %lld, "
+                   "\"conflicts_per_sec\": %.0f, \"props_per_sec\": %.0f, \"peak_rss_kb\": %lld, \"wrong\": %s}%s\n",
+                R.name.c_str(), R.status.c_str(), R.time, R.conflicts, R.propagations, R.conflicts / t, R.propagations / t,
+                R.rss, R.wrong ? "true" : "false", i + 1 < (int)results.size() ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"total_time\": %.3f\n}\n", total);
+    fclose(f);
+}
+
+int main(int argc, char **argv) {
+    int seed = 0, timeout = 120, runs = 3, arg = 1;
+    double tolerance = 0.15;
+    const char *out = "bench/result.json", *baseline = NULL, *dir = "bench/cnf", *filter = "";
+    for (; arg < argc - 1 && argv[arg][0] == '-'; arg++) {
+        if (!strncmp(argv[arg], "--seed=", 7)) seed = atoi(argv[arg] + 7);
+        else if (!strncmp(argv[arg], "--timeout=", 10)) timeout = atoi(argv[arg] + 10);
+        else if (!strncmp(argv[arg], "--runs=", 7)) runs = std::max(1, atoi(argv[arg] + 7));
+        else if (!strncmp(argv[arg], "--tolerance=", 12)) tolerance = atof(argv[arg] + 12);
+        else if (!strncmp(argv[arg], "--baseline=", 11)) baseline = argv[arg] + 11;
+        else if (!strncmp(argv[arg], "--out=", 6)) out = argv[arg] + 6;
+        else if (!strncmp(argv[arg], "--dir=", 6)) dir = argv[arg] + 6;
+        else if (!strncmp(argv[arg], "--filter=", 9)) filter = argv[arg] + 9;
+        else break;
+    }
+    if (arg != argc - 1) {
+        printf("usage: %s [--seed=n] [--timeout=sec] [--runs=n] [--tolerance=frac] [--baseline=json] [--out=json] [--dir=cnf_dir] [--filter=name] <solver>\n", argv[0]);
+        return 1;
+    }
+    const char *solver = argv[arg];
+    std::vector<Result> base, results;
+    if (baseline && !read_baseline(baseline, base)) printf("c no baseline at %s, nothing to compare\n", baseline);
+    mkdir(dir, 0755);
+    std::vector<Instance> S = suite(seed);
+    int bad = 0;
+    printf("%-16s %-14s %9s %11s %12s %12s %9s  %s\n", "instance", "status", "time(s)", "conflicts", "confl/s", "props/s", "rss(MB)", "baseline");
+    for (int i = 0; i < (int)S.size(); i++) {
+        if (!strstr(S[i].name.c_str(), filter)) continue;
+        std::string path = std::string(dir) + "/" + S[i].name + ".cnf";
+        write_cnf(S[i], path);
+        Result R = run(solver, S[i], path, seed, timeout);
+        for (int r = 1; r < runs && R.status != "TIMEOUT"; r++) {  // Keep the fastest run, the search itself is deterministic.
+            Result again = run(solver, S[i], path, seed, timeout);
+            again.wrong |= R.wrong, again.rss = std::max(again.rss, R.rss);
+            if (again.time < R.time) R = again;
+        }
+        results.push_back(R);
+        double t = std::max(R.time, 1e-6);
+        std::string cmp = "-";
+        for (int j = 0; j < (int)base.size(); j++) {
+            if (base[j].name != R.name) continue;
+            char s[128];
+            sprintf(s, "%+.1f%% time, %+.1f%% conflicts", 100 * (R.time / std::max(base[j].time, 1e-3) - 1),
+                    100 * ((double)R.conflicts / std::max(base[j].conflicts, 1LL) - 1));
+            cmp = s;
+            if (R.time > base[j].time * (1 + tolerance) && R.time - base[j].time > 0.2) cmp += "  REGRESSION", bad++;
+            if (base[j].status != R.status && (base[j].status == "SATISFIABLE" || base[j].status == "UNSATISFIABLE"))
+                cmp += "  STATUS CHANGED", bad++;
+        }
+        if (R.wrong) cmp += "  WRONG ANSWER", bad++;
+        printf("%-16s %-14s %9.3f %11lld %12.0f %12.0f %9.1f  %s\n", R.name.c_str(), R.status.c_str(), R.time, R.conflicts,
+               R.conflicts / t, R.propagations / t, R.rss / 1024.0, cmp.c_str());
+        fflush(stdout);
+    }
+    write_report(out, solver, seed, results);
+    printf("c report written to %s, %d problem(s)\n", out, bad);
+    return bad ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+#include "internal.hpp"
+#include <algorithm>
+
+int Solver::cube(int depth, std::vector<int> &cubes) {  // Split the formula into cubes of up to depth decisions, 20 if none is left.
+    backtrack(0);
+    if (propagate() != -1) return 20;
+    std::vector<double> score(vars + 1, 0);             // Candidates by their occurrences, short clauses weigh more.
+    for (int i = 0; i < (int)origin_DB.size(); i++) {
+        Clause &c = clause_DB[origin_DB[i]];
+        for (int j = 0; j < c.size; j++) score[abs(c[j])] += 1.0 / (1 << std::min(c.size, 20));
+    }
+    cube_order.clear();
+    for (int v = 1; v <= vars; v++) if (!eliminated[v] && score[v] > 0) cube_order.push_back(v);
+    std::stable_sort(cube_order.begin(), cube_order.end(), [&](int a, int b) { return score[a] > score[b]; });
+    std::vector<int> prefix;
+    cubes.clear(), split(depth, prefix, cubes);
+    backtrack(0);
+    return cubes.empty() ? 20 : 0;
+}
+
+void Solver::split(int depth, std::vector<int> &prefix, std::vector<int> &cubes) {
+    if (propagate() != -1) { ++cube_refuted; return; }
+    int var = depth > 0 ? lookahead() : 0;
+    if (var < 0) { ++cube_refuted; return; }            // Both branches of a variable failed.
+    if (var == 0) {                                     // Deep enough, or nothing left to split on.
+        cubes.insert(cubes.end(), prefix.begin(), prefix.end()), cubes.push_back(0);
+        return;
+    }
+    int l = pos_in_trail.size();
+    for (int s = 0; s < 2; s++) {
+        int lit = s ? -var : var;
+        prefix.push_back(lit), pos_in_trail.push_back(trail.size()), assign(lit, l + 1, -1);
+        split(depth - 1, prefix, cubes);
+        backtrack(l), prefix.pop_back();
+    }
+}
+
+int Solver::lookahead() {                               // The candidate whose branches both propagate the most, -1 if the node fails.
+    int l = pos_in_trail.size(), best = 0, tried = 0;
+    double best_score = -1;
+    for (int i = 0; i < (int)cube_order.size() && tried < 32; i++) {
+        int var = cube_order[i], counts[2] = {0, 0};
+        if (value(var)) continue;
+        ++tried;
+        for (int s = 0; s < 2 && !value(var); s++) {
+            int lit = s ? -var : var, before = trail.size();
+            pos_in_trail.push_back(trail.size()), assign(lit, l + 1, -1), ++lookaheads;
+            bool failed = propagate() != -1;
+            counts[s] = trail.size() - before;
+            backtrack(l);
+            if (!failed) continue;
+            assign(-lit, l, -1);                        // A failed literal: its negation holds in this node.
+            if (propagate() != -1) return -1;
+        }
+        if (value(var)) continue;
+        double score = (double)(counts[0] + 1) * (counts[1] + 1);
+        if (score > best_score) best = var, best_score = score;
+    }
+    return best;
+}
@@ -0,0 +1,185 @@
+#include "internal.hpp"
+#include <algorithm>
+
+int Solver::find_xors() {                           // x1 ^ ... ^ xk = rhs is encoded by the 2^(k-1) clauses of one parity.
+    if (xor_size < 2 || proof) return 0;            // Combined rows are not RUP, so no XORs with proofs.
+    int limit = std::min(xor_size, 6);
+    std::vector<int> cand, sorted, start;           // Candidate clauses and their variables in order.
+    for (int i = 0; i < (int)origin_DB.size(); i++) {
+        Clause &c = clause_DB[origin_DB[i]];
+        if (c.size < 2 || c.size > limit) continue;
+        cand.push_back(origin_DB[i]), start.push_back(sorted.size());
+        for (int j = 0; j < c.size; j++) sorted.push_back(abs(c[j]));
+        std::sort(sorted.end() - c.size, sorted.end());
+    }
+    std::vector<int> order(cand.size());
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+    auto size = [&](int i) { return clause_DB[cand[i]].size; };
+    auto less = [&](int a, int b) {                 // By size, then by the variables.
+        if (size(a) != size(b)) return size(a) < size(b);
+        return std::lexicographical_compare(&sorted[start[a]], &sorted[start[a]] + size(a), &sorted[start[b]], &sorted[start[b]] + size(b));
+    };
+    std::sort(order.begin(), order.end(), less);
+    int found = 0;
+    for (int i = 0, j; i < (int)order.size(); i = j) {
+        int a = order[i], k = size(a);
+        uint64_t patterns[2] = {0, 0};              // The sign patterns seen, by the parity of their negative literals.
+        for (j = i; j < (int)order.size() && !less(a, order[j]); j++) {
+            Clause &c = clause_DB[cand[order[j]]];
+            int pattern = 0;
+            for (int l = 0; l < k; l++)
+                if (c[l] < 0) pattern |= 1 << (std::lower_bound(&sorted[start[a]], &sorted[start[a]] + k, -c[l]) - &sorted[start[a]]);
+            patterns[__builtin_popcount(pattern) & 1] |= 1ULL << pattern;
+        }
+        for (int p = 0; p < 2; p++) {
+            if (__builtin_popcountll(patterns[p]) != 1 << (k - 1)) continue;
+            xors.push_back(k), xors.push_back(!p);  // Each clause excludes an assignment of parity p.
+            for (int l = 0; l < k; l++) xors.push_back(sorted[start[a] + l]), frozen[sorted[start[a] + l]] = 1;
+            ++found;
+        }
+    }
+    xor_found = found;
+    return found;
+}
+
+int Solver::gauss_init() {                          // Reduced row echelon form of the XORs at level 0.
+    if (xors.empty()) return 0;
+    int rows = 0, cols = 0;
+    for (int i = 0; i < (int)xors.size(); i += xors[i] + 2, rows++)
+        for (int j = 0; j < xors[i]; j++) {
+            int v = xors[i + 2 + j];
+            if (value(v) == 0 && column[v] < 0) column[v] = cols++;
+        }
+    if ((long long)rows * (cols + 1) > (1LL << 22)) {   // Too large to check rows on every assignment.
+        for (int v = 1; v <= vars; v++) column[v] = -1;
+        if (verbosity > 0) printf("c gauss: %d x %d matrix is too large, skipped\n", rows, cols);
+        return xors.clear(), 0;
+    }
+    gauss.init(rows, cols);
+    for (int v = 1; v <= vars; v++) if (column[v] >= 0) gauss.var[column[v]] = v;
+    for (int i = 0, r = 0; i < (int)xors.size(); i += xors[i] + 2, r++) {
+        if (xors[i + 1]) gauss.flip(r, cols);
+        for (int j = 0; j < xors[i]; j++) {
+            int v = xors[i + 2 + j];
+            if (value(v) == 0) gauss.flip(r, column[v]);
+            else if (value(v) == 1) gauss.flip(r, cols);
+        }
+    }
+    for (int r = 0; r < gauss.rows; ) {
+        int c = 0;
+        while (c < cols && !gauss.get(r, c)) c++;
+        if (c == cols) {                            // 0 = rhs: redundant, or the XORs contradict.
+            if (gauss.rhs(r)) return 20;
+            gauss.move(r, --gauss.rows);
+            continue;
+        }
+        gauss.basic[r] = c, gauss.watchers[c].push_back(r);
+        for (int s = 0; s < gauss.rows; s++) if (s != r && gauss.get(s, c)) gauss.add(s, r);
+        r++;
+    }
+    if (verbosity > 0) printf("c gauss: %d XORs, %d x %d matrix\n", xor_found, gauss.rows, cols);
+    for (int r = 0; r < gauss.rows; r++) gauss_queue.push_back(r);   // Units at level 0.
+    if (gauss_check() != -1) return 20;
+    return propagate() == -1 ? 0 : 20;
+}
+
+int Solver::gauss_propagate(int var) {              // Check the rows watching an assigned variable, a conflict or -1.
+    int c = column[var], j = 0;
+    std::vector<int> &ws = gauss.watchers[c];       // A row needs two unassigned columns to stay silent.
+    for (int i = 0; i < (int)ws.size(); i++)
+        if (gauss.watches(ws[i], c)) gauss_queue.push_back(ws[i]), ws[j++] = ws[i];
+    ws.resize(j);
+    return gauss_check();
+}
+
+int Solver::gauss_check() {
+    gauss_dirty = false;
+    while (!gauss_queue.empty()) {
+        int r = gauss_queue.back(), cref;
+        gauss_queue.pop_back();
+        if ((cref = gauss_row(r)) != -1) return gauss_queue.clear(), cref;
+    }
+    return -1;
+}
+
+int Solver::gauss_row(int r) {                      // Keep the basic variable unassigned, imply it when it is the last one.
+    uint64_t *row = gauss.row(r);
+    int b = gauss.basic[r], unassigned = 0, free_col = -1, parity = gauss.rhs(r), top = 0;
+    bool basic_free = value(gauss.var[b]) == 0;
+    int wc = gauss.watch[r];
+    if (basic_free && wc >= 0 && wc != b && gauss.get(r, wc) && value(gauss.var[wc]) == 0) return -1;   // Both watches still unassigned.
+    for (int w = 0; w < gauss.words; w++)
+        for (uint64_t x = row[w]; x; x &= x - 1) {
+            int c = w * 64 + __builtin_ctzll(x);
+            if (c >= gauss.cols) break;
+            int v = gauss.var[c];
+            if (value(v) != 0) { parity ^= value(v) == 1, top = std::max(top, level(v)); continue; }
+            if (c != b) free_col = c;
+            if (++unassigned > 1 && basic_free) {       // Watch the other unassigned column instead.
+                gauss.watch[r] = free_col, gauss.watchers[free_col].push_back(r);
+                return -1;
+            }
+        }
+    if (!basic_free && free_col >= 0) {             // Pivot on an unassigned column, the rows that change are checked again.
+        gauss.basic[r] = free_col, gauss.watchers[free_col].push_back(r), ++gauss_pivots;
+        for (int s = 0; s < gauss.rows; s++)
+            if (s != r && gauss.get(s, free_col)) gauss.add(s, r), gauss_queue.push_back(s);
+        gauss_queue.push_back(r);
+        return -1;
+    }
+    std::vector<int> &c = xor_lits;                 // The variables of the row, the reason or the conflict.
+    c.clear();
+    for (int w = 0; w < gauss.words; w++)
+        for (uint64_t x = row[w]; x; x &= x - 1) {
+            int col = w * 64 + __builtin_ctzll(x);
+            if (col < gauss.cols) c.push_back(gauss.var[col]);
+        }
+    if (unassigned == 1) {                          // Only the basic variable is unassigned.
+        int v = gauss.var[b];
+        xor_reasons.push_back(c.size()), xor_reasons.insert(xor_reasons.end(), c.begin(), c.end());
+        assign(parity ? v : -v, top, -2 - ((int)xor_reasons.size() - (int)c.size() - 1)), ++gauss_props;
+        return -1;
+    }
+    if (!parity) return -1;
+    for (int i = 0; i < (int)c.size(); i++) c[i] = value(c[i]) == 1 ? -c[i] : c[i];
+    ++gauss_conflicts;
+    return xor_clause(c);
+}
+
+int Solver::xor_clause(std::vector<int> &c) {       // Add a clause derived from the rows, the highest levels watched first.
+    for (int w = 0; w < 2 && w < (int)c.size(); w++) {
+        int best = w;
+        for (int i = w + 1; i < (int)c.size(); i++)
+            if (value(c[i]) != -1 || (value(c[best]) == -1 && level(abs(c[i])) > level(abs(c[best])))) best = i;
+        std::swap(c[w], c[best]);
+    }
+    int cref = add_learnt(c, calc_lbd(&c[0], c.size()));
+    Clause &cl = clause_DB[cref];                   // The rows derive it again, so it is never kept for good.
+    cl.xor_row = 1, cl.tier = std::max((int)cl.tier, (int)Clause::TIER2);
+    return cref;
+}
+
+int Solver::xor_reason(int var) {                   // The reason clause of a literal implied by a row, built when asked for.
+    int k = -2 - reason(var), n = xor_reasons[k];
+    std::vector<int> &c = xor_lits;
+    c.clear();
+    for (int i = k + 1; i <= k + n; i++) {
+        int u = xor_reasons[i];
+        c.push_back(value(u) == 1 ? (u == var ? u : -u) : (u == var ? -u : u));
+    }
+    return reason(var) = xor_clause(c);
+}
+
+void Solver::compact_xor_reasons() {                // Keep the rows of the implied literals still on the trail.
+    std::vector<int> kept;
+    for (int i = 0; i < (int)trail.size(); i++) {
+        int &r = reason(abs(trail[i]));
+        if (r >= -1) continue;
+        if (level(abs(trail[i])) == 0) { r = -1; continue; }   // Level 0 reasons are never used.
+        int k = -2 - r;
+        r = -2 - (int)kept.size();
+        kept.insert(kept.end(), xor_reasons.begin() + k, xor_reasons.begin() + k + xor_reasons[k] + 1);
+    }
+    xor_reasons.swap(kept);
+    xor_compact = std::max(1 << 16, 2 * (int)xor_reasons.size());
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+class Matrix {                              // Bit-packed XOR rows, the column after the variables is the right-hand side.
+public:
+    int rows, cols, words;                  // cols variables, words 64-bit words per row.
+    std::vector<uint64_t> bits;             // Row r starts at bits[r * words].
+    std::vector<int> var,                   // The variable of each column.
+                     basic,                 // The column of each row that appears in no other row.
+                     watch;                 // Another unassigned column of each row, -1 if none.
+    std::vector<std::vector<int> > watchers;    // The rows with a column as basic or watch, stale ones are dropped on a visit.
+
+    Matrix(): rows(0), cols(0), words(0) {}
+
+    void init(int r, int c) {
+        rows = r, cols = c, words = (c + 64) / 64;
+        bits.assign((size_t)r * words, 0), var.assign(c, 0), basic.assign(r, -1), watch.assign(r, -1);
+        watchers.assign(c, std::vector<int>());
+    }
+
+    void clear() { rows = cols = words = 0, bits.clear(), var.clear(), basic.clear(), watch.clear(), watchers.clear(); }
+
+    uint64_t *row(int r)         { return &bits[(size_t)r * words]; }
+    bool get(int r, int c)       { return row(r)[c >> 6] >> (c & 63) & 1; }
+    void flip(int r, int c)      { row(r)[c >> 6] ^= 1ULL << (c & 63); }
+    int  rhs(int r)              { return get(r, cols); }
+    bool watches(int r, int c)   { return basic[r] == c || watch[r] == c; }
+
+    void add(int to, int from) {            // Row to ^= row from, a plain loop the compiler vectorizes.
+        uint64_t *__restrict t = row(to);
+        const uint64_t *__restrict f = row(from);
+        for (int i = 0; i < words; i++) t[i] ^= f[i];
+    }
+
+    void move(int to, int from) {           // Overwrite row to with row from.
+        uint64_t *t = row(to), *f = row(from);
+        for (int i = 0; i < words; i++) t[i] = f[i];
+        basic[to] = basic[from], watch[to] = watch[from];
+    }
+};
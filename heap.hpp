@@ -1,15 +1,15 @@
+#pragma once
 #include <vector>
 #include <fstream>
-#define left(x) (x << 1 | 1)
-#define right(x) ((x + 1) << 1)
-#define father(x) ((x - 1) >> 1)
+#define child(x, i) (D * (x) + 1 + (i))
+#define father(x) (((x) - 1) / D)
 
-template<class Comp>
+template<class Comp, int D = 2>   // A D-ary heap, D = 4 halves the depth and keeps the children in one cache line.
 class Heap {
     Comp lt;
     std::vector<int> heap;
     std::vector<int> pos;
-    
+
     void up(int v) {
         int x = heap[v], p = father(v);
         while (v && lt(x, heap[p])) {
@@ -20,11 +20,13 @@ class Heap {
     }
 
     void down(int v) {
-        int x = heap[v];
-        while (left(v) < (int)heap.size()){
-            int child = right(v) < (int)heap.size() && lt(heap[right(v)], heap[left(v)]) ? right(v) : left(v);
-            if (!lt(heap[child], x)) break;
-            heap[v] = heap[child], pos[heap[v]] = v, v = child;
+        int x = heap[v], size = heap.size();
+        while (child(v, 0) < size) {
+            int best = child(v, 0), last = child(v, D) < size ? child(v, D) : size;
+            for (int c = best + 1; c < last; c++)
+                if (lt(heap[c], heap[best])) best = c;
+            if (!lt(heap[best], x)) break;
+            heap[v] = heap[best], pos[heap[v]] = v, v = best;
         }
         heap[v] = x, pos[x] = v;
     }
@@ -32,15 +34,17 @@ class Heap {
 public:
     void setComp   (Comp c)              { lt = c; }
     bool empty     ()              const { return heap.size() == 0; }
+    int  top       ()              const { return heap[0]; }
     bool inHeap    (int n)         const { return n < (int)pos.size() && pos[n] >= 0; }
     void update    (int x)               { up(pos[x]); }
+    void clear     ()                    { heap.clear(), pos.clear(); }
 
     void insert(int x) {
-        if ((int)pos.size() < x + 1) 
+        if ((int)pos.size() < x + 1)
             pos.resize(x + 1, -1);
         pos[x] = heap.size();
         heap.push_back(x);
-        up(pos[x]); 
+        up(pos[x]);
     }
 
     int pop() {
@@ -49,7 +53,9 @@ public:
         pos[heap[0]] = 0, pos[x] = -1;
         heap.pop_back();
         if (heap.size() > 1) down(0);
-        return x; 
+        return x;
     }
 };
 
+#undef child
+#undef father
@@ -0,0 +1,187 @@
+#include "internal.hpp"
+#include <algorithm>
+
+int Solver::inprocess() {
+    backtrack(0);
+    if (propagate() != -1) return 20;
+    log_units();
+    ++inprocessings;
+    for (int i = 0; i < (int)trail.size(); i++) reason(abs(trail[i])) = -1;   // Level 0 needs no reasons.
+    long long work = (propagations - inprocess_propagations) * inprocess_effort;
+    double t = wall_clock();
+    seen.assign(2 * vars + 1, 0);
+    int before = pre_failed, res = probe(work / 20);
+    std::vector<int>().swap(seen);
+    inprocess_failed += pre_failed - before, log_units();
+    double u = wall_clock();
+    probe_time += u - t;
+    if (res != 20) res = substitute(work / 10 + 2 * vars);
+    t = wall_clock(), substitute_time += t - u;
+    if (res != 20) res = vivify(work / 20);
+    vivify_time += wall_clock() - t;
+    if (res == 20) return 20;
+    garbage_collect();
+    inprocess_interval += 5000, inprocess_limit = conflicts + inprocess_interval;
+    inprocess_propagations = propagations;
+    if (verbosity > 0) printf("c inprocess %d: %d failed literals, %d substituted, %d vivified clauses\n",
+        inprocessings, inprocess_failed, substituted, vivified);
+    return 0;
+}
+
+void Solver::log_units() {                          // Clauses satisfied at level 0 may be the reasons of the units.
+    for (; proof && logged_units < (int)trail.size(); logged_units++) proof->add(&trail[logged_units], 1);
+}
+
+int Solver::substitute(long long limit) {           // Equivalent literals from the SCCs of the binary implication graph.
+    int n = 2 * vars + 1, counter = 0, components = 0;
+    std::vector<int> order(n, -1), low(n, 0), comp(n, -1), repr(n, 0), stack, scc;
+    std::vector<std::pair<int, int> > call;         // Depth-first search frames: literal and next watcher.
+    ticks = 0, limit_mark = 0;
+    for (int root = -vars; root <= vars && ticks < limit && !over_limits(ticks); root++) {
+        if (!root || order[lit_index(root)] >= 0 || value(root) || eliminated[abs(root)]) continue;
+        order[lit_index(root)] = low[lit_index(root)] = counter++, stack.push_back(root);
+        call.push_back(std::make_pair(root, 0));
+        while (!call.empty() && ticks < limit && !over_limits(ticks)) {
+            int p = call.back().first, e = call.back().second, pi = lit_index(p);
+            std::vector<Watcher> &ws = watch(p);
+            if (e < (int)ws.size()) {                   // p implies the other literal of a binary clause.
+                call.back().second++, ticks++;
+                int q = ws[e].blocker, qi = lit_index(q);
+                if (!ws[e].binary || value(q) || eliminated[abs(q)]) continue;
+                if (order[qi] < 0) {
+                    order[qi] = low[qi] = counter++, stack.push_back(q);
+                    call.push_back(std::make_pair(q, 0));
+                }
+                else if (comp[qi] < 0) low[pi] = std::min(low[pi], order[qi]);
+                continue;
+            }
+            call.pop_back();
+            if (!call.empty()) {
+                int parent = lit_index(call.back().first);
+                low[parent] = std::min(low[parent], low[pi]);
+            }
+            if (low[pi] != order[pi]) continue;
+            scc.clear();                                // p is the root of a component.
+            do { scc.push_back(stack.back()), comp[lit_index(stack.back())] = components, stack.pop_back(); } while (scc.back() != p);
+            components++;
+            if (scc.size() == 1 || repr[lit_index(scc[0])]) continue;   // Single, or the negation of a done component.
+            int r = scc[0];
+            for (int i = 0; i < (int)scc.size(); i++) {
+                int l = scc[i];
+                if (comp[lit_index(-l)] == comp[pi]) {  // l and -l are equivalent.
+                    if (proof) proof->add(&(l = -l), 1);
+                    return 20;
+                }
+                if (frozen[abs(l)] > frozen[abs(r)] || (frozen[abs(l)] == frozen[abs(r)] && abs(l) < abs(r))) r = l;
+            }
+            for (int i = 0; i < (int)scc.size(); i++)   // Frozen variables are kept, the others are replaced by r.
+                if (scc[i] != r && !frozen[abs(scc[i])]) repr[lit_index(scc[i])] = r, repr[lit_index(-scc[i])] = -r;
+        }
+        if (!call.empty()) break;                       // Out of budget inside a search, the finished components are exact.
+    }
+    for (int v = 1; v <= vars; v++) {                   // v = r for the model: saved as the clauses (v, -r) and (-v, r).
+        int r = repr[lit_index(v)];
+        if (!r) continue;
+        elim_stack.push_back(v), elim_stack.push_back(-r), elim_stack.push_back(2);
+        elim_stack.push_back(-v), elim_stack.push_back(r), elim_stack.push_back(2);
+        eliminated[v] = 1, substitutes[v] = r, ++substituted;
+    }
+    std::vector<int> units, deleted;                    // Deleted clauses are logged after every addition.
+    for (int d = 0; d < 2; d++) {                       // Replace the literals, drop the level 0 ones.
+        std::vector<int> &db = d ? learnt_DB : origin_DB;
+        for (int i = 0; i < (int)db.size(); i++) {
+            Clause &c = clause_DB[db[i]];
+            if (c.deleted) continue;
+            time_stamp += 2;
+            int k = 0, old = deleted.size();
+            bool sat = false, changed = false;
+            if (proof) deleted.push_back(c.size), deleted.insert(deleted.end(), &c[0], &c[0] + c.size);
+            for (int j = 0; j < c.size && !sat; j++) {
+                int lit = repr[lit_index(c[j])] ? repr[lit_index(c[j])] : c[j], var = abs(lit), s = lit > 0 ? time_stamp : time_stamp - 1;
+                changed |= lit != c[j];
+                if (value(lit) == 1 || mark[var] == (lit > 0 ? time_stamp - 1 : time_stamp)) sat = true;
+                else if (value(lit) == -1 || mark[var] == s) changed = true;
+                else mark[var] = s, c[k++] = lit;
+            }
+            if (!sat && !changed) { deleted.resize(old); continue; }
+            if (!sat && proof) proof->add(&c[0], k);
+            if (!sat && k == 0) return 20;
+            if (!sat && k == 1) units.push_back(c[0]);
+            if (sat || k == 1) { clause_DB.free(db[i]); continue; }
+            clause_DB.wasted += c.size - k, c.size = k;
+        }
+        int sz = 0;
+        for (int i = 0; i < (int)db.size(); i++) if (!clause_DB[db[i]].deleted) db[sz++] = db[i];
+        db.resize(sz);
+    }
+    for (int i = 0; proof && i < (int)deleted.size(); i += deleted[i] + 1) proof->remove(&deleted[i + 1], deleted[i]);
+    for (int v = -vars; v <= vars; v++) if (v) watch(v).clear();
+    for (int d = 0; d < 2; d++) {
+        std::vector<int> &db = d ? learnt_DB : origin_DB;
+        for (int i = 0; i < (int)db.size(); i++) attach(db[i]);
+    }
+    sort_watches();
+    for (int i = 0; i < (int)units.size(); i++) {
+        if (value(units[i]) == -1) return 20;
+        if (value(units[i]) == 0) assign(units[i], 0, -1);
+    }
+    return propagate() == -1 ? 0 : 20;
+}
+
+int Solver::vivify(long long limit) {               // Shorten clauses by propagating the negations of their literals.
+    std::vector<int> candidates, lits, shorter;
+    for (int i = 0; i < (int)learnt_DB.size(); i++)     // Kept learnt clauses first, then the original ones.
+        if (clause_DB[learnt_DB[i]].tier != Clause::LOCAL) candidates.push_back(learnt_DB[i]);
+    candidates.insert(candidates.end(), origin_DB.begin(), origin_DB.end());
+    long long start = propagations;
+    int n = candidates.size();
+    limit_mark = 0;
+    for (int k = 0; k < n && propagations - start < limit && !over_limits(propagations - start); k++) {
+        int cref = candidates[(vivify_next + k) % n];
+        Clause &c = clause_DB[cref];
+        if (c.deleted || c.size <= 2) continue;
+        lits.assign(&c[0], &c[0] + c.size), shorter.clear();
+        bool sat = false, keep = false;
+        for (int i = 0; i < (int)lits.size() && !sat && !keep; i++) {
+            int lit = lits[i];
+            if (value(lit) == -1) continue;             // Implied false, it can go.
+            if (value(lit) == 1) {                      // Implied true: the clause is satisfied or shortened with lit.
+                if (level(abs(lit)) == 0) sat = true;
+                else if (reason(abs(lit)) == cref) keep = true;
+                else shorter.push_back(lit), keep = shorter.size() == lits.size();
+                break;
+            }
+            shorter.push_back(lit);
+            pos_in_trail.push_back(trail.size());
+            assign(-lit, pos_in_trail.size(), -1);
+            if (propagate() != -1) break;               // The negations of shorter conflict.
+        }
+        backtrack(0);
+        if (!sat && (keep || shorter.size() == lits.size())) continue;
+        if (!sat && proof) proof->add(shorter);
+        if (proof) proof->remove(lits.data(), lits.size());
+        clause_DB.free(cref);
+        if (sat) continue;
+        ++vivified, vivify_removed += lits.size() - shorter.size();
+        if (shorter.size() == 1) {
+            assign(shorter[0], 0, -1);
+            if (propagate() != -1) return 20;
+            log_units();
+        }
+        else if (clause_DB[cref].learnt) {
+            int lbd = clause_DB[cref].lbd, tier = clause_DB[cref].tier, xor_row = clause_DB[cref].xor_row;
+            int id = add_learnt(shorter, std::min(lbd, (int)shorter.size() - 1));
+            clause_DB[id].tier = std::min(tier, (int)clause_DB[id].tier), clause_DB[id].xor_row = xor_row;
+            if (xor_row) clause_DB[id].tier = std::max((int)clause_DB[id].tier, (int)Clause::TIER2);
+        }
+        else origin_DB.push_back(add_clause(shorter));
+    }
+    vivify_next = n ? (vivify_next + n / 4) % n : 0;
+    for (int d = 0; d < 2; d++) {                       // Drop the replaced clauses, their watchers go with the collection.
+        std::vector<int> &db = d ? learnt_DB : origin_DB;
+        int sz = 0;
+        for (int i = 0; i < (int)db.size(); i++) if (!clause_DB[db[i]].deleted) db[sz++] = db[i];
+        db.resize(sz);
+    }
+    return 0;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "EasySAT.hpp"
+
+// Shorthands for the solver's own source files. They are macros so value(lit) and friends
+// stay lvalues next to members of the same name, and are kept out of the public header.
+#define lit_index(lit) (2 * (lit) ^ ((lit) >> 31))      // Remapping a literal to an index, 2v for v and 2v-1 for -v.
+#define value(lit) (value[lit_index(lit)])              // Get the value of a literal without branching on its sign.
+#define watch(lit) (watches[lit_index(lit)])            // Get the watchers of a literal.
+#define level(var) (vardata[var].level)                 // Get the decision level of a variable.
+#define reason(var) (vardata[var].reason)               // Get the reason clause of a variable.
@@ -0,0 +1,432 @@
+/************************************************************************************
+EasySAT: A CDCL SAT Solver
+================================================================================
+Copyright (c) 2022 SeedSolver Beijing.
+https://seedsolver.com
+help@seedsolver.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+************************************************************************************/
+#include "EasySAT.hpp"
+#include <thread>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+double time_limit = 0, report_interval = 0;     // Resource limits and progress reports from the command line.
+long long conflict_limit = 0;
+int memory_limit = 0;
+
+void handle_signal(int sig) {                   // The first signal stops the search, the second one exits at once.
+    if (!Solver::interrupted.exchange(true)) return;
+    const char msg[] = "c interrupted\ns UNKNOWN\n";
+    if (write(1, msg, sizeof(msg) - 1)) {}
+    _exit(1);
+}
+
+bool set_limits(Solver &S) {                    // Limits count from the start of the run, false if already exceeded.
+    double left = time_limit - (wall_clock() - S.start_time);
+    S.time_limit = time_limit > 0 ? left : 0, S.conflict_limit = conflict_limit, S.memory_limit = memory_limit;
+    return time_limit <= 0 || left > 0;
+}
+
+void printResult(Solver &S, int res) {
+    if (Solver::interrupted) printf("c interrupted\n");
+    S.print_stats();
+    if (res == 10) {
+        printf("s SATISFIABLE\n");
+        S.printModel();
+    }
+    else if (res == 20) printf("s UNSATISFIABLE\n");
+    else printf("s UNKNOWN\n");
+}
+
+int portfolio(char *filename, int threads, int effort, int walk, int inproc, int xors, int seed) {
+    ClauseExchange exchange(threads, 20);
+    std::vector<Solver> solvers(threads);
+    std::vector<int> results(threads, 0);
+    std::atomic<int> winner(-1);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) workers.push_back(std::thread([&, t]() {
+        Solver &S = solvers[t];
+        S.exchange = &exchange, S.pre_effort = effort, S.walk_effort = walk, S.inprocess_effort = inproc, S.xor_size = xors, S.parse_threads = 1;
+        S.rng = 0x9E3779B97F4A7C15ULL * (seed + 1);
+        int res = S.parse(filename);
+        if (res == -1) { results[t] = res; return; }
+        if (res != 20) res = set_limits(S) ? S.preprocess() : 0;    // Deterministic, so all members eliminate the same variables.
+        if (t == 0) S.report_interval = report_interval;
+        if (res != 20) S.diversify(t), res = set_limits(S) ? S.solve() : 0;
+        results[t] = res;
+        int none = -1;
+        if (res && winner.compare_exchange_strong(none, t)) exchange.stop = true;
+    }));
+    for (int t = 0; t < threads; t++) workers[t].join();
+    if (results[0] == -1) return printf("c PARSE ERROR! %s\n", solvers[0].parse_error.c_str()), 1;
+    if (winner < 0) printResult(solvers[0], 0);
+    else printf("c solved by thread %d\n", winner.load()), printResult(solvers[winner], results[winner]);
+    return 0;
+}
+
+struct BatchJob {                               // One instance of a batch: a CNF file, or the text of a CNF read from stdin.
+    int id;
+    bool in_memory;
+    std::string name, text;
+    BatchJob(): id(0), in_memory(false) {}
+};
+
+class BatchQueue {                              // Jobs from the reader to the workers, bounded so stdin is not read far ahead.
+    std::deque<BatchJob> jobs;
+    std::mutex lock;
+    std::condition_variable changed;
+    size_t limit;
+    bool closed;
+
+public:
+    BatchQueue(size_t n): limit(n), closed(false) {}
+
+    void push(BatchJob &job) {
+        std::unique_lock<std::mutex> l(lock);
+        while (jobs.size() >= limit) changed.wait(l);
+        jobs.push_back(BatchJob()), std::swap(jobs.back(), job);
+        changed.notify_all();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> l(lock);
+        closed = true, changed.notify_all();
+    }
+
+    bool pop(BatchJob &job) {                   // False once the queue is closed and empty.
+        std::unique_lock<std::mutex> l(lock);
+        while (jobs.empty() && !closed) changed.wait(l);
+        if (jobs.empty()) return false;
+        std::swap(job, jobs.front()), jobs.pop_front();
+        changed.notify_all();
+        return true;
+    }
+};
+
+void json_string(std::string &out, const std::string &s) {
+    char hex[8];
+    out += '"';
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned char c = s[i];
+        if (c == '"' || c == '\\') out += '\\', out += c;
+        else if (c < 32) snprintf(hex, sizeof(hex), "\\u%04x", c), out += hex;
+        else out += c;
+    }
+    out += '"';
+}
+
+int batch(char *source, int threads, int effort, int walk, int inproc, int xors, int seed) {
+    bool in_memory = !strcmp(source, "-");      // "-": DIMACS on stdin, each instance begins with a "c instance" line.
+    FILE *in = in_memory ? stdin : fopen(source, "r");
+    if (!in) return printf("c cannot open %s: %s\n", source, strerror(errno)), 1;
+    BatchQueue queue(4 * threads);
+    std::mutex output;
+    int counts[4] = {0, 0, 0, 0};               // SAT, UNSAT, UNKNOWN and errors.
+    double start = wall_clock();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) workers.push_back(std::thread([&]() {
+        Solver S;                               // Reset for every instance, its buffers stay allocated.
+        BatchJob job;
+        std::string line;
+        char num[64];
+        while (queue.pop(job)) {
+            S.reset();
+            S.pre_effort = effort, S.walk_effort = walk, S.inprocess_effort = inproc, S.xor_size = xors, S.parse_threads = 1;
+            S.rng = 0x9E3779B97F4A7C15ULL * (seed + 1);
+            int res = job.in_memory ? S.parse(job.text.data(), job.text.data() + job.text.size()) : S.parse(&job.name[0]);
+            double parsed = wall_clock();
+            if (res == 0 && set_limits(S)) res = S.preprocess();
+            if (res == 0) res = set_limits(S) ? S.solve() : 0;
+            int kind = res == 10 ? 0 : res == 20 ? 1 : res == 0 ? 2 : 3;
+            const char *names[] = {"SAT", "UNSAT", "UNKNOWN", "ERROR"};
+            snprintf(num, sizeof(num), "{\"id\":%d,\"name\":", job.id), line = num;
+            json_string(line, job.name);
+            line += ",\"result\":\"", line += names[kind], line += '"';
+            if (kind == 3) line += ",\"error\":", json_string(line, S.parse_error);
+            else {
+                snprintf(num, sizeof(num), ",\"vars\":%d,\"clauses\":%d,\"conflicts\":%d", S.vars, S.clauses, S.conflicts), line += num;
+                snprintf(num, sizeof(num), ",\"parse_time\":%.4f,\"time\":%.4f", parsed - S.start_time, wall_clock() - S.start_time), line += num;
+            }
+            if (kind == 0) {
+                line += ",\"model\":[";
+                for (int i = 1; i <= S.vars; i++) snprintf(num, sizeof(num), i > 1 ? ",%d" : "%d", S.model[i] * i), line += num;
+                line += ']';
+            }
+            line += "}\n";
+            std::lock_guard<std::mutex> l(output);
+            fputs(line.c_str(), stdout), fflush(stdout), ++counts[kind];
+        }
+    }));
+    BatchJob job;
+    int jobs = 0;
+    auto submit = [&]() { queue.push(job), job.id = ++jobs, job.in_memory = in_memory; };   // The queue takes the text.
+    job.in_memory = in_memory;
+    char *buffer = NULL;
+    size_t capacity = 0;
+    bool started = false;                       // Whether the current stdin instance has a marker or any text.
+    ssize_t n;
+    while ((n = getline(&buffer, &capacity, in)) > 0 && !Solver::interrupted) {
+        std::string line(buffer, n);
+        if (!in_memory) {                       // A list of files, one per line.
+            size_t end = line.find_last_not_of(" \t\r\n");
+            if (end == std::string::npos) continue;
+            job.name = line.substr(0, end + 1), submit();
+        }
+        else if (!line.compare(0, 10, "c instance")) {
+            if (started) submit();
+            size_t begin = line.find_first_not_of(" \t", 10), end = line.find_last_not_of(" \t\r\n");
+            job.name = begin != std::string::npos && end >= begin ? line.substr(begin, end - begin + 1) : "-";
+            job.text.clear(), started = true;
+        }
+        else if (started || line.find_first_not_of(" \t\r\n") != std::string::npos) {
+            if (!started) job.name = "-", job.text.clear(), started = true;
+            job.text += line;
+        }
+    }
+    if (in_memory && started) submit();
+    free(buffer);
+    if (!in_memory) fclose(in);
+    queue.close();
+    for (int t = 0; t < threads; t++) workers[t].join();
+    fprintf(stderr, "c batch: %d SAT, %d UNSAT, %d UNKNOWN, %d errors in %.2fs on %d threads\n",
+        counts[0], counts[1], counts[2], counts[3], wall_clock() - start, threads);
+    return 0;
+}
+
+int cube(char *filename, int depth, int effort, int xors) {
+    Solver S;
+    S.pre_effort = effort, S.xor_size = xors;
+    int res = S.parse(filename);
+    if (res == -1) return printf("c PARSE ERROR! %s\n", S.parse_error.c_str()), 1;
+    if (res != 20) res = S.preprocess();
+    std::vector<int> cubes;
+    if (res != 20) res = S.cube(depth, cubes);
+    int n = 0;
+    for (int i = 0; i < (int)cubes.size(); i++) {       // iCNF assumption lines, as read by --conquer.
+        if (i == 0 || !cubes[i - 1]) fputs("a ", stdout);
+        printf(cubes[i] ? "%d " : "0\n", cubes[i]), n += !cubes[i];
+    }
+    printf("c cube: %d cubes of depth %d, %d refuted branches, %lld lookaheads in %.2fs\n",
+        n, depth, S.cube_refuted, S.lookaheads, wall_clock() - S.start_time);
+    if (res == 20) printf("s UNSATISFIABLE\n");
+    return 0;
+}
+
+struct ConquerWorker {                          // A child process solving one cube at a time.
+    pid_t pid;
+    FILE *to, *from;                            // Cube indices in, one result line per cube out.
+    int cube;                                   // The cube being solved, -1 when idle.
+};
+
+void conquer_worker(Solver &S, std::vector<std::vector<int> > &cubes, FILE *in, FILE *out) {
+    char *buffer = NULL;
+    size_t capacity = 0;
+    std::string line;
+    char num[64];
+    while (getline(&buffer, &capacity, in) > 0) {   // Learnt clauses are kept from one cube to the next.
+        long long conflicts = S.conflicts, propagations = S.propagations;
+        int id = atoi(buffer), res = set_limits(S) ? S.solve(cubes[id]) : 0;
+        std::vector<int> lits;                      // The model of a SAT cube, the failed assumptions of an UNSAT one.
+        if (res == 10) for (int i = 1; i <= S.vars; i++) lits.push_back(S.model[i] * i);
+        else if (res == 20) lits = S.core;
+        snprintf(num, sizeof(num), "%d %d %lld %lld %zu", id, res, S.conflicts - conflicts, S.propagations - propagations, lits.size()), line = num;
+        for (int i = 0; i < (int)lits.size(); i++) snprintf(num, sizeof(num), " %d", lits[i]), line += num;
+        line += '\n';
+        fputs(line.c_str(), out), fflush(out);
+    }
+    free(buffer);
+}
+
+int conquer(char *filename, char *cube_file, int workers, int effort, int walk, int inproc, int xors, int seed) {
+    std::vector<std::vector<int> > cubes;
+    FILE *in = fopen(cube_file, "r");
+    if (!in) return printf("c cannot open %s: %s\n", cube_file, strerror(errno)), 1;
+    char *buffer = NULL;
+    size_t capacity = 0;
+    while (getline(&buffer, &capacity, in) > 0) {   // "a <literals> 0" lines, the others are ignored.
+        if (buffer[0] != 'a') continue;
+        cubes.push_back(std::vector<int>());
+        for (char *p = buffer + 1, *end; ; p = end) {
+            long lit = strtol(p, &end, 10);
+            if (end == p || !lit) break;
+            cubes.back().push_back(lit);
+        }
+    }
+    free(buffer), fclose(in);
+    if (cubes.empty()) cubes.push_back(std::vector<int>());   // No cubes: solve the whole formula.
+    Solver S;
+    S.pre_effort = effort, S.walk_effort = walk, S.inprocess_effort = inproc, S.xor_size = xors;
+    S.rng = 0x9E3779B97F4A7C15ULL * (seed + 1);
+    int res = S.parse(filename);
+    if (res == -1) return printf("c PARSE ERROR! %s\n", S.parse_error.c_str()), 1;
+    for (int i = 0; i < (int)cubes.size(); i++)     // Cube variables are assumed, so they must survive preprocessing.
+        for (int j = 0; j < (int)cubes[i].size(); j++) S.freeze(abs(cubes[i][j]));
+    if (res != 20) res = S.preprocess();
+    std::vector<char> state(cubes.size(), 0);       // 0 waiting, 1 sent, 2 refuted by the core of another cube.
+    std::vector<ConquerWorker> pool;
+    fflush(stdout);
+    for (int w = 0; w < workers && res != 20; w++) {    // The children start from the parsed and preprocessed solver.
+        int down[2], up[2];
+        if (pipe(down) || pipe(up)) return printf("c pipe: %s\n", strerror(errno)), 1;
+        pid_t pid = fork();
+        if (pid < 0) return printf("c fork: %s\n", strerror(errno)), 1;
+        if (pid == 0) {
+            for (int i = 0; i < (int)pool.size(); i++) fclose(pool[i].to), fclose(pool[i].from);
+            close(down[1]), close(up[0]);
+            FILE *from = fdopen(down[0], "r"), *to = fdopen(up[1], "w");
+            conquer_worker(S, cubes, from, to);
+            _exit(0);
+        }
+        close(down[0]), close(up[1]);
+        ConquerWorker worker = {pid, fdopen(down[1], "w"), fdopen(up[0], "r"), -1};
+        pool.push_back(worker);
+    }
+    int next = 0, busy = 0, counts[3] = {0, 0, 0}, pruned = 0, stopped = 0;   // SAT, UNSAT and UNKNOWN cubes.
+    long long conflicts = 0, propagations = 0;
+    std::vector<int> model;
+    auto send = [&](ConquerWorker &w) {             // The next cube not refuted yet, or the end of the work.
+        while (next < (int)cubes.size() && state[next]) next++;
+        if (next == (int)cubes.size() || res) { fclose(w.to), w.to = NULL, w.cube = -1; return; }
+        state[next] = 1, w.cube = next, ++busy;
+        fprintf(w.to, "%d\n", next++), fflush(w.to);
+    };
+    for (int w = 0; w < (int)pool.size(); w++) send(pool[w]);
+    std::vector<struct pollfd> fds(pool.size());
+    buffer = NULL, capacity = 0;
+    while (busy > 0 && !res && !Solver::interrupted) {
+        for (int w = 0; w < (int)pool.size(); w++) fds[w].fd = pool[w].cube >= 0 ? fileno(pool[w].from) : -1, fds[w].events = POLLIN;
+        if (poll(fds.data(), fds.size(), 1000) <= 0) continue;
+        for (int w = 0; w < (int)pool.size(); w++) {
+            if (pool[w].cube < 0 || !(fds[w].revents & (POLLIN | POLLHUP))) continue;
+            --busy;
+            if (getline(&buffer, &capacity, pool[w].from) <= 0) {   // The worker died, its cube stays unknown.
+                printf("c worker %d stopped on cube %d\n", w, pool[w].cube), ++counts[2];
+                fclose(pool[w].to), pool[w].to = NULL, pool[w].cube = -1;
+                continue;
+            }
+            char *p = buffer;
+            strtol(p, &p, 10);                              // The cube index, it is the one sent.
+            int r = strtol(p, &p, 10);
+            long long c = strtoll(p, &p, 10), pr = strtoll(p, &p, 10);
+            std::vector<int> lits(strtol(p, &p, 10));
+            for (int i = 0; i < (int)lits.size(); i++) lits[i] = strtol(p, &p, 10);
+            conflicts += c, propagations += pr;
+            ++counts[r == 10 ? 0 : r == 20 ? 1 : 2];
+            if (r == 10) res = 10, model.swap(lits);
+            else if (r == 20 && lits.empty()) res = 20;     // Refuted without assumptions: the formula is UNSAT.
+            else if (r == 20)                               // Cubes containing the failed assumptions are refuted too.
+                for (int i = next; i < (int)cubes.size(); i++) {
+                    if (state[i]) continue;
+                    bool all = true;
+                    for (int j = 0; j < (int)lits.size() && all; j++)
+                        all = std::find(cubes[i].begin(), cubes[i].end(), lits[j]) != cubes[i].end();
+                    if (all) state[i] = 2, ++pruned;
+                }
+            send(pool[w]);
+        }
+    }
+    free(buffer);
+    for (int w = 0; w < (int)pool.size(); w++) {    // The others are stopped once the answer is known.
+        if (pool[w].cube >= 0) kill(pool[w].pid, SIGKILL), ++stopped;
+        if (pool[w].to) fclose(pool[w].to);
+        fclose(pool[w].from), waitpid(pool[w].pid, NULL, 0);
+    }
+    if (!res && !stopped && !counts[2] && !Solver::interrupted) res = 20;   // Every cube is refuted.
+    if (Solver::interrupted) printf("c interrupted\n");
+    printf("c conquer: %d cubes on %d workers: %d SAT, %d UNSAT, %d refuted by cores, %d UNKNOWN, %d stopped\n",
+        (int)cubes.size(), (int)pool.size(), counts[0], counts[1], pruned, counts[2], stopped);
+    printf("c conquer: %lld conflicts, %lld propagations in %.2fs\n", conflicts, propagations, wall_clock() - S.start_time);
+    if (res == 10) {
+        printf("s SATISFIABLE\nv ");
+        for (int i = 0; i < (int)model.size(); i++) printf("%d ", model[i]);
+        puts("0");
+    }
+    else if (res == 20) printf("s UNSATISFIABLE\n");
+    else printf("s UNKNOWN\n");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int threads = 0, effort = 1, walk = 10, inproc = 1, xors = 6, verbosity = 0, seed = 0, arg = 1;
+    bool batch_mode = false;
+    char *proof_file = NULL, *cube_file = NULL;
+    int cube_depth = 0;
+    for (; arg < argc - 1 && argv[arg][0] == '-'; arg++) {
+        if (!strcmp(argv[arg], "-t")) threads = atoi(argv[++arg]);
+        else if (!strcmp(argv[arg], "-v")) verbosity = 1;
+        else if (!strcmp(argv[arg], "--batch")) batch_mode = true;
+        else if (!strncmp(argv[arg], "--pre=", 6)) effort = atoi(argv[arg] + 6);
+        else if (!strncmp(argv[arg], "--walk=", 7)) walk = atoi(argv[arg] + 7);
+        else if (!strncmp(argv[arg], "--inprocess=", 12)) inproc = atoi(argv[arg] + 12);
+        else if (!strncmp(argv[arg], "--xor=", 6)) xors = atoi(argv[arg] + 6);
+        else if (!strncmp(argv[arg], "--seed=", 7)) seed = atoi(argv[arg] + 7);
+        else if (!strncmp(argv[arg], "--time=", 7)) time_limit = atof(argv[arg] + 7);
+        else if (!strncmp(argv[arg], "--conflicts=", 12)) conflict_limit = atoll(argv[arg] + 12);
+        else if (!strncmp(argv[arg], "--memory=", 9)) memory_limit = atoi(argv[arg] + 9);
+        else if (!strncmp(argv[arg], "--report=", 9)) report_interval = atof(argv[arg] + 9);
+        else if (!strncmp(argv[arg], "--proof=", 8)) proof_file = argv[arg] + 8;
+        else if (!strncmp(argv[arg], "--cube=", 7)) cube_depth = atoi(argv[arg] + 7);
+        else if (!strncmp(argv[arg], "--conquer=", 10)) cube_file = argv[arg] + 10;
+        else break;
+    }
+    if (xors < 0 || xors > 6) printf("c --xor=%d: the XOR size must be between 0 and 6\n", xors);
+    if (arg != argc - 1 || threads < 0 || cube_depth < 0 || xors < 0 || xors > 6) {
+        printf("usage: %s [-t threads] [-v] [--batch] [--pre=effort] [--walk=effort] [--inprocess=effort] [--xor=size(0-6)] [--seed=n] [--time=sec] [--conflicts=n] [--memory=MB] [--report=sec] [--proof=file] <cnf_file | ->\n", argv[0]);
+        printf("       %s --batch [-t workers] [options] <file_list | ->   (JSON lines, stdin instances begin with \"c instance [name]\")\n", argv[0]);
+        printf("       %s --cube=depth [--pre=effort] <cnf_file>   (cubes as \"a <literals> 0\" lines)\n", argv[0]);
+        printf("       %s --conquer=cube_file [-t workers] [options] <cnf_file>\n", argv[0]);
+        return 1;
+    }
+    if (threads == 0) threads = batch_mode || cube_file ? std::max(1, (int)std::thread::hardware_concurrency()) : 1;
+    if (proof_file && (batch_mode || cube_depth || cube_file)) return printf("c --proof cannot be used with --batch, --cube or --conquer\n"), 1;
+    if (proof_file && threads > 1) return printf("c --proof needs a single thread, imported clauses cannot be checked\n"), 1;
+    signal(SIGINT, handle_signal), signal(SIGTERM, handle_signal);
+    if (batch_mode) return batch(argv[arg], threads, effort, walk, inproc, xors, seed);
+    if (cube_depth) return cube(argv[arg], cube_depth, effort, xors);
+    if (cube_file) return conquer(argv[arg], cube_file, threads, effort, walk, inproc, xors, seed);
+    if (threads > 1) return portfolio(argv[arg], threads, effort, walk, inproc, xors, seed);
+    Solver S;
+    Proof proof;
+    if (proof_file && !proof.open(proof_file)) return printf("c cannot open proof file %s\n", proof_file), 1;
+    if (proof_file) S.proof = &proof;
+    S.pre_effort = effort, S.walk_effort = walk, S.inprocess_effort = inproc, S.xor_size = xors, S.verbosity = verbosity, S.rng = 0x9E3779B97F4A7C15ULL * (seed + 1), S.report_interval = report_interval;
+    int res = S.parse(argv[arg]);
+    if (res == -1) return printf("c PARSE ERROR! %s\n", S.parse_error.c_str()), 1;
+    if (res != 20 && set_limits(S)) {
+        res = S.preprocess();
+        if (effort > 0) printf("c preprocess: %d eliminated, %d subsumed, %d strengthened, %d failed literals\n",
+            S.pre_eliminated, S.pre_subsumed, S.pre_strengthened, S.pre_failed);
+    }
+    res = res == 20 ? 20 : set_limits(S) ? S.solve() : 0;
+    if (S.proof) {                                  // Complete the proof before the answer is printed.
+        if (res == 20) proof.add(NULL, 0);
+        if (!proof.close()) printf("c error writing proof file %s\n", proof_file);
+    }
+    printResult(S, res);
+    return 0;
+}
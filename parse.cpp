@@ -0,0 +1,276 @@
+#include "internal.hpp"
+#include <thread>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef EASYSAT_ZLIB
+#include <zlib.h>
+#endif
+#ifdef EASYSAT_LZMA
+#include <lzma.h>
+#endif
+
+class InputStream {             // Blocks of complete lines from a plain, gzip or xz file.
+public:
+    enum { MAPPED, RAW, GZIP, XZ };
+    int kind, fd;
+    bool eof, member;           // member: inside a compressed stream that has not ended yet.
+    const char *map;            // The whole file when it is mapped, plain files are never copied.
+    size_t map_size, map_pos;
+    std::vector<char> raw, text;// Compressed input, and decompressed text whose first keep bytes are a partial line.
+    size_t raw_pos, keep;
+#ifdef EASYSAT_ZLIB
+    z_stream gz;
+#endif
+#ifdef EASYSAT_LZMA
+    lzma_stream xz;
+#endif
+
+    InputStream(): kind(RAW), fd(-1), eof(false), member(false), map(NULL), map_size(0), map_pos(0), raw_pos(0), keep(0) {}
+    ~InputStream() {
+        if (map) munmap((void *)map, map_size);
+#ifdef EASYSAT_ZLIB
+        if (kind == GZIP) inflateEnd(&gz);
+#endif
+#ifdef EASYSAT_LZMA
+        if (kind == XZ) lzma_end(&xz);
+#endif
+        if (fd > 0) close(fd);
+    }
+
+    bool fill_raw() {                                       // Read more compressed input, false at the end of file.
+        if (raw_pos > 0) raw.erase(raw.begin(), raw.begin() + raw_pos), raw_pos = 0;
+        size_t old = raw.size();
+        raw.resize(old + (1 << 20));
+        ssize_t n = read(fd, &raw[old], 1 << 20);
+        raw.resize(old + (n > 0 ? n : 0));
+        return n > 0;
+    }
+
+    bool open(const char *filename, std::string &error) {
+        fd = strcmp(filename, "-") ? ::open(filename, O_RDONLY) : 0;
+        if (fd < 0) return error = std::string("cannot open ") + filename + ": " + strerror(errno), false;
+        struct stat st;
+        unsigned char magic[6] = {0};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && pread(fd, magic, 6, 0) >= 0
+            && magic[0] != 0x1f && magic[0] != 0xfd) {      // A plain regular file is mapped.
+            kind = MAPPED, map_size = st.st_size;
+            if (map_size == 0) return eof = true;
+            map = (const char *)mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) return map = NULL, error = std::string("cannot map ") + filename, false;
+            madvise((void *)map, map_size, MADV_SEQUENTIAL);
+            return true;
+        }
+        while (raw.size() < 6 && fill_raw());
+        if (raw.size() >= 2 && (unsigned char)raw[0] == 0x1f && (unsigned char)raw[1] == 0x8b) {
+#ifdef EASYSAT_ZLIB
+            kind = GZIP, memset(&gz, 0, sizeof(gz));
+            if (inflateInit2(&gz, 15 + 32) != Z_OK) return error = "cannot initialize zlib", false;
+#else
+            return error = "gzip input is not supported by this build", false;
+#endif
+        }
+        else if (raw.size() >= 6 && !memcmp(&raw[0], "\xfd" "7zXZ", 6)) {
+#ifdef EASYSAT_LZMA
+            kind = XZ, xz = LZMA_STREAM_INIT;
+            if (lzma_stream_decoder(&xz, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) return error = "cannot initialize liblzma", false;
+#else
+            return error = "xz input is not supported by this build", false;
+#endif
+        }
+        return true;
+    }
+
+    int decompress(size_t want, std::string &error) {      // Append up to want bytes of text, 0 at the end of input.
+        size_t old = text.size();
+        text.resize(old + want);
+        size_t got = 0;
+        while (got == 0) {
+            if (raw_pos == raw.size() && !fill_raw()) {
+#ifdef EASYSAT_LZMA
+                if (kind == XZ && member) {                 // Let liblzma check the end of a concatenated stream.
+                    lzma_ret r = LZMA_OK;
+                    xz.next_in = NULL, xz.avail_in = 0, xz.next_out = (uint8_t *)&text[old], xz.avail_out = want;
+                    while (r == LZMA_OK && xz.avail_out == want) r = lzma_code(&xz, LZMA_FINISH);
+                    got = want - xz.avail_out;
+                    if (r == LZMA_STREAM_END) member = false;
+                    else if (r != LZMA_OK) return error = "truncated xz input", -1;
+                    if (got > 0) break;
+                }
+#endif
+                if (member) return error = kind == GZIP ? "truncated gzip input" : "truncated xz input", -1;
+                break;
+            }
+            size_t in = raw.size() - raw_pos, used = 0;
+            if (kind == RAW) {
+                got = std::min(in, want), memcpy(&text[old], &raw[raw_pos], got), used = got;
+            }
+#ifdef EASYSAT_ZLIB
+            else if (kind == GZIP) {
+                gz.next_in = (Bytef *)&raw[raw_pos], gz.avail_in = in;
+                gz.next_out = (Bytef *)&text[old], gz.avail_out = want;
+                int r = inflate(&gz, Z_NO_FLUSH);
+                used = in - gz.avail_in, got = want - gz.avail_out, member = true;
+                if (r == Z_STREAM_END) inflateReset(&gz), member = false;   // Concatenated gzip members.
+                else if (r != Z_OK && r != Z_BUF_ERROR) return error = "corrupted gzip input", -1;
+            }
+#endif
+#ifdef EASYSAT_LZMA
+            else if (kind == XZ) {
+                xz.next_in = (const uint8_t *)&raw[raw_pos], xz.avail_in = in;
+                xz.next_out = (uint8_t *)&text[old], xz.avail_out = want;
+                lzma_ret r = lzma_code(&xz, LZMA_RUN);
+                used = in - xz.avail_in, got = want - xz.avail_out, member = true;
+                if (r != LZMA_OK && r != LZMA_STREAM_END) return error = "corrupted xz input", -1;
+            }
+#endif
+            raw_pos += used;
+        }
+        text.resize(old + got);
+        return got > 0;
+    }
+
+    int next(const char *&begin, const char *&end, size_t want, std::string &error) {   // 1: a block, 0: end of file, -1: error.
+        if (eof) return 0;
+        if (kind == MAPPED) {
+            if (map_pos > 0) madvise((void *)map, map_pos & ~(size_t)4095, MADV_DONTNEED);   // Drop the parsed pages from RSS.
+            size_t stop = std::min(map_size, map_pos + want);
+            while (stop < map_size && map[stop - 1] != '\n') stop++;
+            begin = map + map_pos, end = map + stop, map_pos = stop, eof = stop == map_size;
+            return 1;
+        }
+        if (keep > 0) text.erase(text.begin(), text.end() - keep);
+        else text.clear();
+        int r = 1;
+        while (r > 0 && text.size() < want) r = decompress(want, error);
+        if (r < 0) return -1;
+        if (r == 0) eof = true, keep = 0;
+        else {                                              // Keep the partial last line for the next block.
+            size_t stop = text.size();
+            while (stop > 0 && text[stop - 1] != '\n') stop--;
+            keep = text.size() - stop;
+            if (stop == 0) keep = 0, stop = text.size();    // A single line longer than the block.
+        }
+        begin = text.data(), end = text.data() + text.size() - keep;
+        return begin < end || !eof ? 1 : 0;
+    }
+};
+
+const char *read_whitespace(const char *p, const char *end) {     // Aid function for parser
+    while (p < end && ((*p >= 9 && *p <= 13) || *p == 32)) ++p;
+    return p;
+}
+
+const char *read_until_new_line(const char *p, const char *end) { // Aid function for parser
+    while (p < end && *p != '\n') ++p;
+    return p < end ? p + 1 : p;
+}
+
+const char *read_int(const char *p, const char *end, long long *i) {   // Aid function for parser, NULL if malformed.
+    bool sym = true; *i = 0;
+    p = read_whitespace(p, end);
+    if (p < end && *p == '-') sym = false, ++p;
+    if (p == end || *p < '0' || *p > '9') return NULL;
+    while (p < end && *p >= '0' && *p <= '9') {
+        *i = *i * 10 + *p - '0', ++p;
+        if (*i > 0x7fffffff) return NULL;
+    }
+    if (!sym) *i = -(*i);
+    return p;
+}
+
+struct ParseChunk {             // The literals of a block of complete lines, 0 ends a clause.
+    std::vector<int> lits;
+    long long vars, clauses;    // The 'p cnf' header if the block has one, vars is -1 otherwise.
+    std::string error;
+
+    void scan(const char *p, const char *end) {
+        lits.clear(), vars = -1;
+        while (p < end) {
+            p = read_whitespace(p, end);
+            if (p == end) break;
+            if (*p == 'c') p = read_until_new_line(p, end);
+            else if (*p == 'p') {                                                           // Deal with 'p cnf' line.
+                if (end - p < 5 || strncmp(p, "p cnf", 5) || vars >= 0
+                    || !(p = read_int(p + 5, end, &vars)) || !(p = read_int(p, end, &clauses)) || vars < 0 || clauses < 0) {
+                    error = "malformed or repeated 'p cnf' line"; return;
+                }
+            }
+            else {
+                long long lit;
+                const char *q = read_int(p, end, &lit);
+                if (!q) {
+                    error = (*p == '-' || (*p >= '0' && *p <= '9')) ? "literal out of range" : std::string("unexpected character '") + *p + "'"; return;
+                }
+                lits.push_back(lit), p = q;
+            }
+        }
+    }
+};
+
+int Solver::parse(char *filename) {
+    InputStream in;
+    if (!in.open(filename, parse_error)) return -1;
+    int threads = parse_threads > 0 ? parse_threads : std::min(8, (int)std::thread::hardware_concurrency());
+    size_t block = 8 << 20;
+    std::vector<ParseChunk> chunks(std::max(threads, 1));
+    std::vector<int> buffer;                                // Save the clause that waiting to push
+    int declared = -1;                                      // The variables of the 'p cnf' line, -1 before it.
+    const char *begin, *end;
+    int r;
+    while ((r = in.next(begin, end, threads > 1 && in.kind == InputStream::MAPPED ? block * threads : block, parse_error)) > 0) {
+        int n = 1;
+        if (threads > 1 && end - begin > (long)block) {     // Scan large blocks in parallel, split at line ends.
+            std::vector<const char *> cut(1, begin);
+            for (int t = 1; t < threads; t++) {
+                const char *p = std::max(cut.back(), begin + (end - begin) * t / threads);
+                while (p < end && p[-1] != '\n') p++;
+                cut.push_back(p);
+            }
+            cut.push_back(end), n = threads;
+            std::vector<std::thread> workers;
+            for (int t = 0; t < n; t++) workers.push_back(std::thread([&, t]() { chunks[t].scan(cut[t], cut[t + 1]); }));
+            for (int t = 0; t < n; t++) workers[t].join();
+        }
+        else chunks[0].scan(begin, end);
+        for (int t = 0; t < n; t++)                         // Add the clauses in the file order.
+            if ((r = add_chunk(chunks[t], declared, buffer)) != 0) return r;
+    }
+    if (r < 0) return -1;
+    return finish_parse(buffer);
+}
+
+int Solver::parse(const char *begin, const char *end) {
+    ParseChunk chunk;
+    std::vector<int> buffer;
+    int declared = -1;
+    chunk.scan(begin, end);
+    int r = add_chunk(chunk, declared, buffer);
+    return r != 0 ? r : finish_parse(buffer);
+}
+
+int Solver::add_chunk(ParseChunk &chunk, int &declared, std::vector<int> &buffer) {
+    if (!chunk.error.empty()) return parse_error = chunk.error, -1;
+    if (chunk.vars >= 0) {
+        if (declared >= 0) return parse_error = "repeated 'p cnf' line", -1;
+        declared = chunk.vars, clauses = chunk.clauses;
+        if (chunk.vars > vars) vars = chunk.vars, alloc_memory();
+    }
+    for (int i = 0; i < (int)chunk.lits.size(); i++) {
+        int lit = chunk.lits[i];
+        if (declared >= 0 && abs(lit) > declared)                                // More variables than the header declares.
+            return parse_error = "literal " + std::to_string(lit) + " out of range, 'p cnf' declares " + std::to_string(declared) + " variables", -1;
+        if (lit != 0) { buffer.push_back(lit); continue; }                       // read a literal
+        if (!add_origin(buffer)) return 20;                                      // Found confliction in origin clauses
+        buffer.clear();                                                          // For the next clause.
+    }
+    return 0;
+}
+
+int Solver::finish_parse(std::vector<int> &buffer) {
+    if (!buffer.empty()) return parse_error = "unexpected end of file inside a clause", -1;
+    sort_watches();
+    return (propagate() == -1 ? 0 : 20);                                                // Simplify by BCP.
+}
@@ -0,0 +1,305 @@
+#include "internal.hpp"
+#include <algorithm>
+
+#define occurs(lit) (occurs[vars + (lit)])                  // Remapping a literal to the clauses containing it.
+#define seen(lit) (seen[vars + (lit)])                      // Remapping a literal to its mark.
+
+int Solver::preprocess() {
+    solve_start = wall_clock();                             // The time limit counts from here until solve().
+    find_xors();                                            // Before elimination, which keeps the XOR variables.
+    if (pre_effort <= 0) return gauss_init();
+    occurs.assign(2 * vars + 1, std::vector<int>());
+    seen.assign(2 * vars + 1, 0);
+    int sz = 0;
+    std::vector<int> old;
+    for (int i = 0; i < (int)origin_DB.size(); i++) {       // Remove false and duplicated literals, satisfied and tautological clauses.
+        int cref = origin_DB[i], k = 0;
+        Clause &c = clause_DB[cref];
+        bool sat = false;
+        if (proof) old.assign(&c[0], &c[0] + c.size);
+        for (int j = 0; j < c.size && !sat; j++) {
+            int lit = c[j];
+            if (value(lit) == 1 || seen(-lit)) sat = true;
+            else if (value(lit) == 0 && !seen(lit)) seen(lit) = 1, c[k++] = lit;
+        }
+        for (int j = 0; j < k; j++) seen(c[j]) = 0;
+        if (proof && (sat || k < c.size)) {                 // Add the shorter clause before deleting the old one.
+            if (!sat) proof->add(&c[0], k);
+            proof->remove(old.data(), old.size());
+        }
+        clause_DB.wasted += c.size - k, c.size = k;
+        if (sat) { clause_DB.free(cref); continue; }
+        if (k == 0) return 20;
+        if (k == 1) {
+            if (value(c[0]) == 0) assign(c[0], 0, -1);
+            clause_DB.free(cref);
+            continue;
+        }
+        origin_DB[sz++] = cref;
+        for (int j = 0; j < k; j++) occurs(c[j]).push_back(cref);
+    }
+    origin_DB.resize(sz);
+    if (occ_propagate() == 20 || subsume() == 20 || eliminate() == 20) return 20;
+    for (int v = -vars; v <= vars; v++) watch(v).clear();   // Watch the simplified clauses again.
+    sz = 0;
+    for (int i = 0; i < (int)origin_DB.size(); i++)
+        if (!clause_DB[origin_DB[i]].deleted) attach(origin_DB[i]), origin_DB[sz++] = origin_DB[i];
+    origin_DB.resize(sz);
+    std::vector<std::vector<int> >().swap(occurs);
+    int res = probe(2000000LL * pre_effort);
+    std::vector<int>().swap(seen);
+    garbage_collect();
+    return res == 20 ? 20 : gauss_init();
+}
+
+void Solver::remove_clause(int cref) {                      // Occurrence lists are cleaned lazily.
+    Clause &c = clause_DB[cref];
+    if (proof && c.size > 1) proof->remove(&c[0], c.size);  // Units stay, they are level 0 assignments.
+    clause_DB.free(cref);
+}
+
+int Solver::strengthen(int cref, int lit) {
+    Clause &c = clause_DB[cref];
+    if (proof) {                                            // Add the strengthened clause, then delete the old one.
+        std::vector<int> shorter;
+        for (int i = 0; i < c.size; i++) if (c[i] != lit) shorter.push_back(c[i]);
+        proof->add(shorter), proof->remove(&c[0], c.size);
+    }
+    for (int i = 0; i < c.size; i++)
+        if (c[i] == lit) { c[i] = c[--c.size], clause_DB.wasted++; break; }
+    std::vector<int> &os = occurs(lit);
+    std::vector<int>::iterator it = std::find(os.begin(), os.end(), cref);
+    if (it != os.end()) *it = os.back(), os.pop_back();
+    pre_strengthened++;
+    if (c.size > 1) { subsume_queue.push_back(cref); return 0; }
+    int unit = c[0];                                        // The clause becomes a unit.
+    remove_clause(cref);
+    if (value(unit) == -1) return 20;
+    if (value(unit) == 0) assign(unit, 0, -1);
+    return 0;
+}
+
+int Solver::occ_propagate() {
+    while (propagated < (int)trail.size()) {
+        int lit = trail[propagated++];
+        std::vector<int> &os = occurs(lit);
+        for (int i = 0; i < (int)os.size(); i++)            // Satisfied clauses.
+            if (!clause_DB[os[i]].deleted) remove_clause(os[i]);
+        std::vector<int>().swap(os);
+        std::vector<int> fs;
+        fs.swap(occurs(-lit));
+        for (int i = 0; i < (int)fs.size(); i++)            // Clauses containing the false literal.
+            if (!clause_DB[fs[i]].deleted && strengthen(fs[i], -lit) == 20) return 20;
+    }
+    return 0;
+}
+
+int Solver::subsume_with(int cref) {
+    Clause &c = clause_DB[cref];
+    if (c.deleted) return 0;
+    int best = c[0], csize = c.size;
+    for (int i = 0; i < csize; i++) {                       // Candidates must contain the least occurring variable.
+        int l = c[i];
+        if (occurs(l).size() + occurs(-l).size() < occurs(best).size() + occurs(-best).size()) best = l;
+        seen(l) = 1;
+    }
+    std::vector<std::pair<int, int> > strengthened;
+    for (int s = 0; s < 2; s++) {
+        std::vector<int> &os = occurs(s ? -best : best);
+        for (int k = 0; k < (int)os.size(); k++) {
+            int d = os[k];
+            Clause &D = clause_DB[d];
+            if (d == cref || D.deleted || D.size < csize) continue;
+            ticks += D.size;
+            int matched = 0, flipped = 0;
+            for (int j = 0; j < D.size && matched >= 0; j++) {
+                if (seen(D[j])) matched++;
+                else if (seen(-D[j])) {
+                    if (flipped) matched = -1;
+                    else flipped = D[j];
+                }
+            }
+            if (matched == csize) remove_clause(d), pre_subsumed++;
+            else if (flipped && matched == csize - 1) strengthened.push_back(std::make_pair(d, flipped));
+        }
+    }
+    for (int i = 0; i < csize; i++) seen(c[i]) = 0;
+    for (int i = 0; i < (int)strengthened.size(); i++)      // Self-subsuming resolution.
+        if (!clause_DB[strengthened[i].first].deleted && strengthen(strengthened[i].first, strengthened[i].second) == 20) return 20;
+    return 0;
+}
+
+bool Solver::subsumed(std::vector<int> &c) {
+    bool res = false;
+    for (int i = 0; i < (int)c.size(); i++) seen(c[i]) = 1;
+    for (int i = 0; i < (int)c.size() && !res; i++) {
+        std::vector<int> &os = occurs(c[i]);
+        for (int k = 0; k < (int)os.size() && !res; k++) {
+            Clause &D = clause_DB[os[k]];
+            if (D.deleted || D.size > (int)c.size()) continue;
+            ticks += D.size;
+            int j = 0;
+            while (j < D.size && seen(D[j])) j++;
+            res = j == D.size;
+        }
+    }
+    for (int i = 0; i < (int)c.size(); i++) seen(c[i]) = 0;
+    return res;
+}
+
+int Solver::subsume() {
+    ticks = 0, limit_mark = 0;
+    long long limit = 20000000LL * pre_effort;
+    subsume_queue = origin_DB;
+    std::sort(subsume_queue.begin(), subsume_queue.end(), [&](int a, int b) { return clause_DB[a].size < clause_DB[b].size; });
+    for (int i = 0; i < (int)subsume_queue.size() && ticks < limit && !over_limits(ticks); i++)   // Strengthened clauses are appended.
+        if (subsume_with(subsume_queue[i]) == 20 || occ_propagate() == 20) return 20;
+    subsume_queue.clear();
+    return 0;
+}
+
+bool Solver::resolve(int p, int n, int v, std::vector<int> &out) {
+    Clause &cp = clause_DB[p], &cn = clause_DB[n];
+    bool tautology = false;
+    out.clear();
+    for (int i = 0; i < cp.size; i++)
+        if (abs(cp[i]) != v) out.push_back(cp[i]), seen(cp[i]) = 1;
+    for (int i = 0; i < cn.size && !tautology; i++) {
+        int lit = cn[i];
+        if (abs(lit) == v || seen(lit)) continue;
+        if (seen(-lit)) tautology = true;
+        else out.push_back(lit);
+    }
+    for (int i = 0; i < cp.size; i++) seen(cp[i]) = 0;
+    ticks += cp.size + cn.size;
+    return !tautology;
+}
+
+int Solver::eliminate() {
+    ticks = 0, limit_mark = 0;
+    long long limit = 20000000LL * pre_effort;
+    std::vector<int> order, pos, neg, resolvent, resolvents;
+    for (int round = 0; round < 3 && ticks < limit && !over_limits(ticks); round++) {
+        int before = pre_eliminated;
+        order.clear();
+        for (int v = 1; v <= vars; v++) if (!value(v) && !eliminated[v] && !frozen[v]) order.push_back(v);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {   // Cheap variables first.
+            return occurs(a).size() * occurs(-a).size() < occurs(b).size() * occurs(-b).size(); });
+        for (int k = 0; k < (int)order.size() && ticks < limit && !over_limits(ticks); k++) {
+            int v = order[k];
+            if (value(v) || eliminated[v]) continue;
+            for (int s = 0; s < 2; s++) {                   // Collect the live clauses and clean the lists.
+                std::vector<int> &os = occurs(s ? -v : v), &out = s ? neg : pos;
+                int sz = 0;
+                for (int i = 0; i < (int)os.size(); i++) if (!clause_DB[os[i]].deleted) os[sz++] = os[i];
+                os.resize(sz), out = os;
+            }
+            if (pos.size() * neg.size() > 1000) continue;
+            bool bounded = true;
+            int count = 0;
+            resolvents.clear();
+            for (int i = 0; i < (int)pos.size() && bounded; i++)
+                for (int j = 0; j < (int)neg.size() && bounded; j++) {
+                    if (!resolve(pos[i], neg[j], v, resolvent)) continue;
+                    if ((int)resolvent.size() > 20 || ++count > (int)(pos.size() + neg.size())) bounded = false;
+                    resolvents.push_back(resolvent.size());
+                    resolvents.insert(resolvents.end(), resolvent.begin(), resolvent.end());
+                }
+            if (!bounded) continue;
+            std::vector<int> &saved_side = pos.size() > neg.size() ? neg : pos;
+            for (int i = 0; i < (int)saved_side.size(); i++) {          // Saved as: witness, other literals, size.
+                Clause &c = clause_DB[saved_side[i]];
+                int witness = pos.size() > neg.size() ? -v : v;
+                elim_stack.push_back(witness);
+                for (int j = 0; j < c.size; j++) if (c[j] != witness) elim_stack.push_back(c[j]);
+                elim_stack.push_back(c.size);
+            }
+            elim_stack.push_back(pos.size() > neg.size() ? v : -v), elim_stack.push_back(1);
+            eliminated[v] = 1, pre_eliminated++;
+            for (int i = 0; i < (int)resolvents.size(); i += resolvents[i] + 1) {   // Added before their antecedents go.
+                resolvent.clear();
+                bool sat = false;
+                for (int j = i + 1; j <= i + resolvents[i] && !sat; j++) {  // Units may have been found meanwhile.
+                    int lit = resolvents[j];
+                    if (value(lit) == 1) sat = true;
+                    else if (value(lit) == 0) resolvent.push_back(lit);
+                }
+                if (sat) continue;
+                if (resolvent.size() == 0) return 20;
+                if (subsumed(resolvent)) continue;          // Forward subsumption.
+                if (proof) proof->add(resolvent);
+                if (resolvent.size() == 1) { assign(resolvent[0], 0, -1); continue; }
+                int cref = clause_DB.alloc(resolvent, false);
+                origin_DB.push_back(cref), subsume_queue.push_back(cref);
+                for (int j = 0; j < (int)resolvent.size(); j++) occurs(resolvent[j]).push_back(cref);
+            }
+            for (int i = 0; i < (int)pos.size(); i++) remove_clause(pos[i]);
+            for (int i = 0; i < (int)neg.size(); i++) remove_clause(neg[i]);
+            std::vector<int>().swap(occurs(v)), std::vector<int>().swap(occurs(-v));
+            if (occ_propagate() == 20) return 20;
+            for (int i = 0; i < (int)subsume_queue.size(); i++)         // Backward subsumption by the resolvents.
+                if (subsume_with(subsume_queue[i]) == 20 || occ_propagate() == 20) return 20;
+            subsume_queue.clear();
+        }
+        if (pre_eliminated == before) break;
+    }
+    return 0;
+}
+
+int Solver::probe(long long limit) {
+    ticks = 0, limit_mark = 0;
+    std::vector<int> units;
+    int k;
+    for (k = 0; k < vars && ticks < limit && !over_limits(ticks); k++) {           // Continue after the variable probed last.
+        int v = (probe_next + k) % vars + 1;
+        if (value(v) || eliminated[v]) continue;
+        for (int s = 0; s < 2; s++) {
+            int lit = s ? -v : v, start = trail.size();
+            pos_in_trail.push_back(start);
+            assign(lit, 1, -1);
+            int confl = propagate();
+            ticks += trail.size() - start;
+            if (confl != -1) {                              // A failed literal, its negation is implied.
+                backtrack(0), pre_failed++, units.clear();
+                int unit = -lit;
+                if (proof) proof->add(&unit, 1);
+                assign(-lit, 0, -1);
+                if (propagate() != -1) return 20;
+                break;
+            }
+            for (int i = start + 1; i < (int)trail.size(); i++) {
+                if (s == 0) seen(trail[i]) = v;
+                else if (seen(trail[i]) == v) units.push_back(trail[i]);   // Implied by both phases.
+            }
+            backtrack(0);
+        }
+        for (int i = 0; i < (int)units.size(); i++) {
+            if (value(units[i]) != 0) continue;
+            if (proof) {                                    // Derived through the two binary clauses with v.
+                int both[2][2] = {{units[i], -v}, {units[i], v}};
+                proof->add(both[0], 2), proof->add(both[1], 2), proof->add(&units[i], 1);
+                proof->remove(both[0], 2), proof->remove(both[1], 2);
+            }
+            assign(units[i], 0, -1);
+        }
+        units.clear();
+        if (propagate() != -1) return 20;
+    }
+    probe_next = (probe_next + k) % std::max(vars, 1);
+    return 0;
+}
+
+void Solver::extend_model() {
+    model.assign(vars + 1, 0);
+    for (int i = 1; i <= vars; i++) model[i] = value(i);
+    for (int i = (int)elim_stack.size() - 1; i > 0; ) {     // Undo the eliminations in reverse order.
+        int sz = elim_stack[i--], witness = elim_stack[i - sz + 1];
+        bool sat = false;
+        for (int j = i - sz + 2; j <= i && !sat; j++) {
+            int lit = elim_stack[j];
+            sat = (lit > 0 ? model[lit] : -model[-lit]) == 1;
+        }
+        if (!sat) model[abs(witness)] = witness > 0 ? 1 : -1;
+        i -= sz;
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+
+class Proof {                               // Binary DRAT output, the file is written by a background thread.
+    FILE *file;
+    std::vector<unsigned char> buffer;      // Filled by the solver, handed to the writer when full.
+    std::deque<std::vector<unsigned char> > queue,  // Full buffers waiting for the writer.
+                                            spare;  // Written buffers kept for reuse.
+    std::mutex lock;
+    std::condition_variable wake, drained;
+    std::thread writer;
+    bool done, failed;
+    enum { capacity = 1 << 22, max_queued = 16 };   // The solver only waits when the disk falls 64MB behind.
+
+    void run() {
+        std::vector<unsigned char> data;
+        std::unique_lock<std::mutex> l(lock);
+        while (true) {
+            while (queue.empty() && !done) wake.wait(l);
+            if (queue.empty()) break;
+            data.swap(queue.front()), queue.pop_front();
+            l.unlock();
+            bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+            data.clear();
+            l.lock();
+            failed |= !ok, spare.push_back(std::vector<unsigned char>()), spare.back().swap(data);
+            drained.notify_one();
+        }
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> l(lock);
+        while (queue.size() >= max_queued) drained.wait(l);
+        queue.push_back(std::vector<unsigned char>()), queue.back().swap(buffer);
+        if (!spare.empty()) buffer.swap(spare.front()), spare.pop_front();
+        buffer.reserve(capacity);
+        wake.notify_one();
+    }
+
+    void put(char type, const int *lits, int n) {
+        size_t start = buffer.size();
+        buffer.push_back(type);
+        for (int i = 0; i < n; i++) {       // 2v for v and 2v+1 for -v, in 7-bit groups.
+            unsigned u = 2 * abs(lits[i]) + (lits[i] < 0);
+            while (u > 127) buffer.push_back((u & 127) | 128), u >>= 7;
+            buffer.push_back(u);
+        }
+        buffer.push_back(0), bytes += buffer.size() - start;
+        if (buffer.size() >= capacity) flush();
+    }
+
+public:
+    long long added, deleted, bytes;
+
+    Proof(): file(NULL), done(false), failed(false), added(0), deleted(0), bytes(0) {}
+    ~Proof() { close(); }
+
+    bool open(const char *filename) {
+        if (!(file = fopen(filename, "wb"))) return false;
+        buffer.reserve(capacity);
+        writer = std::thread(&Proof::run, this);
+        return true;
+    }
+
+    bool close() {                          // Write everything, false if the file could not be written.
+        if (!file) return true;
+        flush();
+        { std::lock_guard<std::mutex> l(lock); done = true; }
+        wake.notify_one(), writer.join();
+        failed |= fclose(file) != 0, file = NULL;
+        return !failed;
+    }
+
+    void add(const int *lits, int n)              { put('a', lits, n), ++added; }
+    void add(const std::vector<int> &c)           { add(c.data(), c.size()); }
+    void remove(const int *lits, int n)           { put('d', lits, n), ++deleted; }
+};
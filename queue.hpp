@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+class Queue {                           // Variable move-to-front (VMTF): variables ordered by their last bump.
+public:
+    struct Link { int prev, next; };
+    std::vector<Link> links;            // Doubly linked list over the variables, 0 ends it.
+    std::vector<long long> stamp;       // Increasing along the list, the front is the last bumped variable.
+    int first, last,                    // The oldest and the most recently bumped variable.
+        search;                         // Every variable after search is assigned.
+    long long time;
+
+    Queue(): first(0), last(0), search(0), time(0) {}
+
+    void clear() { links.clear(), stamp.clear(), first = last = search = 0, time = 0; }
+
+    void dequeue(int v) {
+        Link &l = links[v];
+        if (l.prev) links[l.prev].next = l.next; else first = l.next;
+        if (l.next) links[l.next].prev = l.prev; else last = l.prev;
+    }
+
+    void enqueue(int v) {               // Append v as the most recently bumped variable.
+        links[v].prev = last, links[v].next = 0;
+        if (last) links[last].next = v; else first = v;
+        last = v, stamp[v] = ++time;
+    }
+
+    void grow(int vars) {               // New variables enter at the front, unassigned.
+        int old = links.size() ? links.size() - 1 : 0;
+        links.resize(vars + 1), stamp.resize(vars + 1, 0);
+        for (int v = old + 1; v <= vars; v++) enqueue(v), search = v;
+    }
+
+    void bump(int v) {
+        if (v == last) return;
+        dequeue(v), enqueue(v);
+    }
+
+    void unassigned(int v) {            // Keep the search position before every unassigned variable.
+        if (stamp[v] > stamp[search]) search = v;
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <atomic>
+
+class ClauseRing {                          // Lock-free broadcast ring, one writer and any number of readers.
+    std::vector<std::atomic<int> > data;    // Records: [size, lbd, literals...], wrapping around.
+    unsigned long long mask;
+    std::atomic<unsigned long long> head,   // Everything before head is published.
+                                    reserved;// Everything before reserved may be under writing.
+
+public:
+    ClauseRing(int log_capacity): data(1ULL << log_capacity), mask((1ULL << log_capacity) - 1), head(0), reserved(0) {}
+
+    void push(const std::vector<int> &c, int lbd) {         // Only the owner thread calls push.
+        unsigned long long h = head.load(std::memory_order_relaxed), n = c.size() + 2;
+        if (n > mask) return;
+        reserved.store(h + n, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data[h & mask].store(c.size(), std::memory_order_relaxed);
+        data[(h + 1) & mask].store(lbd, std::memory_order_relaxed);
+        for (int i = 0; i < (int)c.size(); i++) data[(h + 2 + i) & mask].store(c[i], std::memory_order_relaxed);
+        head.store(h + n, std::memory_order_release);
+    }
+
+    bool pull(unsigned long long &cursor, std::vector<int> &c, int &lbd) {  // Read the next record after cursor.
+        unsigned long long h = head.load(std::memory_order_acquire), start = cursor;
+        if (start == h) return false;
+        unsigned long long n = data[start & mask].load(std::memory_order_relaxed);
+        if (h - start > mask + 1 || n > mask || start + 2 + n > h) { cursor = h; return false; }
+        lbd = data[(start + 1) & mask].load(std::memory_order_relaxed);
+        c.resize(n);
+        for (unsigned long long i = 0; i < n; i++) c[i] = data[(start + 2 + i) & mask].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (reserved.load(std::memory_order_relaxed) - start > mask + 1) {      // Lapped by the writer, skip the lost records.
+            cursor = head.load(std::memory_order_acquire); return false;
+        }
+        cursor = start + 2 + n;
+        return true;
+    }
+};
+
+class ClauseExchange {                      // Shared state of a portfolio of solvers.
+public:
+    std::vector<ClauseRing *> rings;        // rings[i] is written by solver i.
+    std::atomic<bool> stop;                 // Set by the first solver that finds an answer.
+    ClauseExchange(int n, int log_capacity): stop(false) {
+        for (int i = 0; i < n; i++) rings.push_back(new ClauseRing(log_capacity));
+    }
+    ~ClauseExchange() { for (int i = 0; i < (int)rings.size(); i++) delete rings[i]; }
+};
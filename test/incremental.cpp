@@ -0,0 +1,96 @@
+// Incremental regression driver: runs solve(assumptions) queries on one solver while clauses are
+// added between them, and checks every answer against a fresh solver given the clauses so far plus
+// the assumptions as unit clauses. Inprocessing is forced early so substitution, probing and
+// vivification run between queries. Returns 1 on the first disagreement.
+#include "EasySAT.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+unsigned long long rng;
+int random(int n) {                                 // The same xorshift64* generator as the solver.
+    rng ^= rng >> 12, rng ^= rng << 25, rng ^= rng >> 27;
+    return (rng * 2685821657736338717ULL >> 33) % n;
+}
+
+int fresh(const std::vector<std::vector<int> > &cls, int added, const std::vector<int> &units) {
+    Solver F;
+    bool ok = true;
+    for (int i = 0; i < added && ok; i++) ok = F.add_origin(cls[i]);
+    for (int i = 0; i < (int)units.size() && ok; i++) ok = F.add_origin(std::vector<int>(1, units[i]));
+    return ok ? F.solve() : 20;
+}
+
+int check(int seed) {                               // The number of wrong answers for one random run.
+    rng = seed * 0x9E3779B97F4A7C15ULL + 1;
+    int n = 20 + random(60), m = n * (300 + random(100)) / 100;
+    std::vector<std::vector<int> > cls;
+    std::vector<int> equal;                         // Pairs of literals the formula makes equal.
+    for (int i = 0; i < n / 4; i++) {               // Equivalences, so inprocessing substitutes variables.
+        int a = random(n) + 1, b = random(n) + 1;
+        if (a == b) continue;
+        if (random(2)) b = -b;
+        cls.push_back({a, -b}), cls.push_back({-a, b}), equal.push_back(a), equal.push_back(b);
+    }
+    for (int i = 0; seed % 2 && i < n / 3; i++) {   // XORs of 2 to 4 variables in direct encoding.
+        int k = 2 + random(3), vs[4], p = random(2);
+        bool dup = false;
+        for (int j = 0; j < k; j++) vs[j] = random(n) + 1;
+        for (int a = 0; a < k; a++) for (int b = a + 1; b < k; b++) dup |= vs[a] == vs[b];
+        for (int mask = 0; !dup && mask < 1 << k; mask++) {
+            if (__builtin_popcount(mask) % 2 != p) continue;
+            std::vector<int> c;
+            for (int j = 0; j < k; j++) c.push_back(mask >> j & 1 ? -vs[j] : vs[j]);
+            cls.push_back(c);
+        }
+    }
+    for (int i = 0; i < m; i++) {
+        std::vector<int> c;
+        for (int k = 0; k < 3; k++) { int v = random(n) + 1; c.push_back(random(2) ? v : -v); }
+        cls.push_back(c);
+    }
+    Solver S;
+    S.inprocess_limit = 20, S.inprocess_interval = 20;
+    int added = cls.size() * 2 / 3, bad = 0;
+    for (int i = 0; i < added; i++) S.add_origin(cls[i]);
+    if (seed % 3 == 0) {                            // Preprocessing needs every variable a query may use frozen.
+        for (int v = 1; v <= n; v++) S.freeze(v);
+        if (S.preprocess() == 20) S.ok = false;
+    }
+    for (int q = 0; q < 40; q++) {
+        if (q % 5 == 4 && added < (int)cls.size()) S.add_origin(cls[added++]);
+        std::vector<int> as;
+        for (int k = q ? random(6) : 0; k > 0; k--) { int v = random(n) + 1; as.push_back(random(2) ? v : -v); }
+        if (q % 8 == 7 && !equal.empty()) {         // Repeated and implied assumptions, more of them than variables.
+            int e = random(equal.size() / 2) * 2, s = random(2) ? 1 : -1;
+            for (int k = 0; k < n; k++) as.push_back(s * equal[e]), as.push_back(s * equal[e + 1]);
+        }
+        int res = S.solve(as), expect = fresh(cls, added, as);
+        if (res != expect) { printf("seed %d query %d: got %d, expected %d\n", seed, q, res, expect); return ++bad; }
+        if (res == 10) {
+            for (int i = 0; i < added; i++) {
+                bool sat = false;
+                for (int j = 0; j < (int)cls[i].size(); j++) sat |= S.model_value(cls[i][j]) == 1;
+                if (!sat) { printf("seed %d query %d: clause %d falsified by the model\n", seed, q, i); return ++bad; }
+            }
+            for (int i = 0; i < (int)as.size(); i++)
+                if (S.model_value(as[i]) != 1) { printf("seed %d query %d: assumption %d false\n", seed, q, as[i]); return ++bad; }
+            if (S.model_value(n + 1) || S.model_value(-n - 1)) { printf("seed %d query %d: value for an unknown variable\n", seed, q); return ++bad; }
+        } else {
+            if (S.model_value(1)) { printf("seed %d query %d: model left from an earlier answer\n", seed, q); return ++bad; }
+            for (int i = 0; i < (int)S.core.size(); i++) {
+                bool in = false;
+                for (int j = 0; j < (int)as.size(); j++) in |= as[j] == S.core[i];
+                if (!in) { printf("seed %d query %d: core literal %d not assumed\n", seed, q, S.core[i]); return ++bad; }
+            }
+            if (fresh(cls, added, S.core) != 20) { printf("seed %d query %d: core is satisfiable\n", seed, q); return ++bad; }
+        }
+    }
+    return bad;
+}
+
+int main(int argc, char **argv) {
+    int runs = argc > 1 ? atoi(argv[1]) : 200, bad = 0;
+    for (int seed = 1; seed <= runs && !bad; seed++) bad += check(seed);
+    printf(bad ? "incremental: FAILED\n" : "incremental: %d runs passed\n", runs);
+    return bad ? 1 : 0;
+}
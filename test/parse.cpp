@@ -0,0 +1,36 @@
+// Parser regression driver: feeds small DIMACS texts to parse(begin, end) and checks the answer
+// and, for malformed input, that a parse error is reported. Returns 1 on the first disagreement.
+#include "EasySAT.hpp"
+#include <cstdio>
+#include <cstring>
+
+struct Case {
+    const char *text;
+    int expect;                                     // The result of parse(), -1 for a parse error.
+    const char *error;                              // A part of parse_error when expect is -1.
+};
+
+int main() {
+    Case cases[] = {
+        {"p cnf 3 2\n1 -2 0\n2 3 0\n", 0, ""},
+        {"c comment\np cnf 2 2\n1 0\n-1 0\n", 20, ""},
+        {"p cnf 3 2\n1 -4 0\n2 3 0\n", -1, "literal -4 out of range"},
+        {"p cnf 3 1\n1 2 3 4 0\n", -1, "literal 4 out of range"},
+        {"p cnf 3 1\n1 2147483648 0\n", -1, "literal out of range"},
+        {"p cnf 3 1\np cnf 3 1\n1 0\n", -1, "'p cnf' line"},
+        {"p cnf 3 1\n1 2\n", -1, "end of file inside a clause"},
+        {"p cnf 3 1\n1 x 0\n", -1, "unexpected character 'x'"},
+    };
+    int n = sizeof(cases) / sizeof(cases[0]), bad = 0;
+    for (int i = 0; i < n; i++) {
+        Solver S;
+        const char *text = cases[i].text;
+        int res = S.parse(text, text + strlen(text));
+        if (res != cases[i].expect || (res == -1 && !strstr(S.parse_error.c_str(), cases[i].error))) {
+            printf("case %d: got %d \"%s\", expected %d \"%s\"\n", i, res, S.parse_error.c_str(), cases[i].expect, cases[i].error);
+            bad++;
+        }
+    }
+    printf(bad ? "parse: FAILED\n" : "parse: %d cases passed\n", n);
+    return bad ? 1 : 0;
+}
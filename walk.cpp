@@ -0,0 +1,95 @@
+#include "internal.hpp"
+#include <cmath>
+
+int Solver::walk() {                                        // ProbSAT (Balint & Schoening, SAT 2012), 10 if it finds a model.
+    ++walks;
+    long long flips = walk_flips;
+    std::vector<int8_t> cur(vars + 1, 0);                   // The assignment of the walk, 1 or -1 per variable.
+    std::vector<char> fixed(vars + 1, 0);                   // Level 0 literals and the assumptions keep their values.
+    for (int i = 0; i < (int)trail.size(); i++)
+        if (level(abs(trail[i])) == 0) fixed[abs(trail[i])] = 1, cur[abs(trail[i])] = trail[i] > 0 ? 1 : -1;
+    for (int i = 0; i < (int)assumptions.size(); i++) {
+        int v = abs(assumptions[i]), s = assumptions[i] > 0 ? 1 : -1;
+        if (fixed[v] && cur[v] != s) return 0;
+        fixed[v] = 1, cur[v] = s;
+    }
+    for (int v = 1; v <= vars; v++) {                       // Start from the saved phases, every other walk from the best trail.
+        if (fixed[v]) continue;
+        int phase = (walks & 1) && local_best[v] ? local_best[v] : saved[v];
+        cur[v] = phase ? phase : (random(2) ? 1 : -1);
+    }
+#define val(lit) ((lit) > 0 ? cur[lit] : -cur[-(lit)])
+    std::vector<int> lits, start(1, 0);                     // The original clauses without fixed literals.
+    for (int i = 0; i < (int)origin_DB.size(); i++) {
+        Clause &c = clause_DB[origin_DB[i]];
+        int old = lits.size();
+        bool sat = false;
+        for (int j = 0; j < c.size && !sat; j++) {
+            if (!fixed[abs(c[j])]) lits.push_back(c[j]);
+            else sat = val(c[j]) == 1;
+        }
+        if (sat) { lits.resize(old); continue; }
+        if ((int)lits.size() == old) return 0;              // Falsified below the search, left to conflict analysis.
+        start.push_back(lits.size());
+    }
+    int n = start.size() - 1;
+    std::vector<int> occ_start(2 * vars + 2, 0), occ(lits.size());   // The clauses of lit from occ[occ_start[lit_index(lit)]].
+    for (int i = 0; i < (int)lits.size(); i++) occ_start[lit_index(lits[i]) + 1]++;
+    for (int i = 1; i < (int)occ_start.size(); i++) occ_start[i] += occ_start[i - 1];
+    std::vector<int> fill(occ_start.begin(), occ_start.end() - 1);
+    for (int c = 0; c < n; c++)
+        for (int i = start[c]; i < start[c + 1]; i++) occ[fill[lit_index(lits[i])]++] = c;
+    std::vector<int> count(n, 0), unsat, unsat_pos(n, -1);  // True literals per clause, and the falsified clauses.
+    for (int c = 0; c < n; c++) {
+        for (int i = start[c]; i < start[c + 1]; i++) count[c] += val(lits[i]) == 1;
+        if (count[c] == 0) unsat_pos[c] = unsat.size(), unsat.push_back(c);
+    }
+    double avg = n ? (double)lits.size() / n : 0, score[64];   // Probability of a flip by its break value.
+    double cb = avg <= 3 ? 2.5 : avg <= 4 ? 2.85 : avg <= 5 ? 3.7 : avg <= 6 ? 5.1 : 7.4;
+    for (int b = 0; b < 64; b++) score[b] = pow(cb, -b);
+    std::vector<double> weight;
+    std::vector<int8_t> best(cur);
+    std::vector<int> flipped;                               // Flipped variables since the best assignment.
+    int least = unsat.size(), initial = least;
+    long long budget = walk_effort * (propagations - walk_propagations) + lits.size();
+    walk_propagations = propagations, ticks = 0, limit_mark = 0;
+    while (!unsat.empty() && ticks < budget && !over_limits(ticks)) {
+        int c = unsat[random(unsat.size())], size = start[c + 1] - start[c];
+        double sum = 0;
+        weight.resize(size);
+        for (int i = 0; i < size; i++) {                    // The clauses only satisfied by the negation of lits[i] break.
+            int neg = lit_index(-lits[start[c] + i]), b = 0;
+            for (int j = occ_start[neg]; j < occ_start[neg + 1]; j++) b += count[occ[j]] == 1;
+            ticks += occ_start[neg + 1] - occ_start[neg] + 1;
+            sum += weight[i] = score[std::min(b, 63)];
+        }
+        double r = sum * random(1 << 30) / (1 << 30);
+        int k = 0;
+        while (k < size - 1 && (r -= weight[k]) > 0) k++;
+        int lit = lits[start[c] + k], v = abs(lit), pos = lit_index(lit), neg = lit_index(-lit);
+        cur[v] = -cur[v], ++walk_flips, flipped.push_back(v);
+        for (int j = occ_start[pos]; j < occ_start[pos + 1]; j++)
+            if (count[occ[j]]++ == 0) {                     // Satisfied now, remove it from the falsified ones.
+                int d = occ[j], last = unsat.back();
+                unsat[unsat_pos[d]] = last, unsat_pos[last] = unsat_pos[d], unsat.pop_back();
+            }
+        for (int j = occ_start[neg]; j < occ_start[neg + 1]; j++)
+            if (--count[occ[j]] == 0) unsat_pos[occ[j]] = unsat.size(), unsat.push_back(occ[j]);
+        ticks += occ_start[pos + 1] - occ_start[pos] + occ_start[neg + 1] - occ_start[neg];
+        if ((int)unsat.size() < least) {                    // A new best assignment, catch up with the flips.
+            least = unsat.size();
+            for (int i = 0; i < (int)flipped.size(); i++) best[flipped[i]] = cur[flipped[i]];
+            flipped.clear();
+        }
+    }
+#undef val
+    if (verbosity > 0) printf("c walk %d: %lld flips, %d -> %d falsified clauses\n", walks, walk_flips - flips, initial, least);
+    for (int v = 1; v <= vars; v++)                         // The best assignment becomes the phases of the search.
+        if (!fixed[v]) saved[v] = local_best[v] = best[v];
+    if (least > 0) return 0;
+    backtrack(0);                                           // A model: assign it as one decision level.
+    pos_in_trail.push_back(trail.size());
+    for (int v = 1; v <= vars; v++)
+        if (value(v) == 0 && !eliminated[v]) assign(v * best[v], 1, -1);
+    return 10;
+}